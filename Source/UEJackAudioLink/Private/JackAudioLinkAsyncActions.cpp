@@ -0,0 +1,165 @@
+#include "JackAudioLinkAsyncActions.h"
+#include "JackRoutingPreset.h"
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+
+static UUEJackAudioLinkSubsystem* GetJackSubsystem()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>() : nullptr;
+}
+
+// Hands the future's value to the action on the game thread, unless the action was collected in the meantime
+template<typename ActionType, typename ResultType>
+static void CompleteOnGameThread(ActionType* Action, TFuture<ResultType>&& Future)
+{
+	TWeakObjectPtr<ActionType> WeakAction(Action);
+	Future.Next([WeakAction](ResultType Result)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakAction, Result = MoveTemp(Result)]()
+		{
+			if (ActionType* LiveAction = WeakAction.Get())
+			{
+				LiveAction->Complete(Result);
+			}
+		});
+	});
+}
+
+UJackRoutingAsyncAction* UJackRoutingAsyncAction::ConnectPortsAsync(UObject* WorldContextObject, const FString& SourcePort, const FString& DestinationPort)
+{
+	UJackRoutingAsyncAction* Action = NewObject<UJackRoutingAsyncAction>();
+	Action->Start = [SourcePort, DestinationPort](UUEJackAudioLinkSubsystem& Subsys) { return Subsys.ConnectPortsAsync(SourcePort, DestinationPort); };
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+UJackRoutingAsyncAction* UJackRoutingAsyncAction::DisconnectPortsAsync(UObject* WorldContextObject, const FString& SourcePort, const FString& DestinationPort)
+{
+	UJackRoutingAsyncAction* Action = NewObject<UJackRoutingAsyncAction>();
+	Action->Start = [SourcePort, DestinationPort](UUEJackAudioLinkSubsystem& Subsys) { return Subsys.DisconnectPortsAsync(SourcePort, DestinationPort); };
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+UJackRoutingAsyncAction* UJackRoutingAsyncAction::ConnectPortsByIndexAsync(UObject* WorldContextObject, EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+																		   EJackPortDirection DestType, const FString& DestClientName, int32 DestPortNumber)
+{
+	UJackRoutingAsyncAction* Action = NewObject<UJackRoutingAsyncAction>();
+	Action->Start = [SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber](UUEJackAudioLinkSubsystem& Subsys)
+	{
+		return Subsys.ConnectPortsByIndexAsync(SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+	};
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+UJackRoutingAsyncAction* UJackRoutingAsyncAction::DisconnectPortsByIndexAsync(UObject* WorldContextObject, EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+																			  EJackPortDirection DestType, const FString& DestClientName, int32 DestPortNumber)
+{
+	UJackRoutingAsyncAction* Action = NewObject<UJackRoutingAsyncAction>();
+	Action->Start = [SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber](UUEJackAudioLinkSubsystem& Subsys)
+	{
+		return Subsys.DisconnectPortsByIndexAsync(SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+	};
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UJackRoutingAsyncAction::Activate()
+{
+	UUEJackAudioLinkSubsystem* Subsys = GetJackSubsystem();
+	if (!Subsys || !Start)
+	{
+		Complete(false);
+		return;
+	}
+	CompleteOnGameThread(this, Start(*Subsys));
+}
+
+void UJackRoutingAsyncAction::Complete(bool bSucceeded)
+{
+	(bSucceeded ? OnSuccess : OnFailure).Broadcast();
+	SetReadyToDestroy();
+}
+
+UJackRoutingMatrixAsyncAction* UJackRoutingMatrixAsyncAction::ApplyRoutingMatrixAsync(UObject* WorldContextObject, const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope)
+{
+	UJackRoutingMatrixAsyncAction* Action = NewObject<UJackRoutingMatrixAsyncAction>();
+	Action->Start = [Edges, Scope](UUEJackAudioLinkSubsystem& Subsys) { return Subsys.ApplyRoutingMatrix(Edges, Scope); };
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+UJackRoutingMatrixAsyncAction* UJackRoutingMatrixAsyncAction::RestoreRoutingPresetAsync(UObject* WorldContextObject, UJackRoutingPreset* Preset)
+{
+	UJackRoutingMatrixAsyncAction* Action = NewObject<UJackRoutingMatrixAsyncAction>();
+	// The preset is read when the node activates, which is right away
+	TWeakObjectPtr<const UJackRoutingPreset> WeakPreset(Preset);
+	Action->Start = [WeakPreset](UUEJackAudioLinkSubsystem& Subsys) { return Subsys.RestoreRoutingPreset(WeakPreset.Get()); };
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UJackRoutingMatrixAsyncAction::Activate()
+{
+	UUEJackAudioLinkSubsystem* Subsys = GetJackSubsystem();
+	if (!Subsys || !Start)
+	{
+		Complete(FJackRoutingResult());
+		return;
+	}
+	CompleteOnGameThread(this, Start(*Subsys));
+}
+
+void UJackRoutingMatrixAsyncAction::Complete(const FJackRoutingResult& Result)
+{
+	(Result.NumFailed > 0 ? OnFailed : OnCompleted).Broadcast(Result);
+	SetReadyToDestroy();
+}
+
+UJackGetClientsAsyncAction* UJackGetClientsAsyncAction::GetConnectedClientsAsync(UObject* WorldContextObject)
+{
+	UJackGetClientsAsyncAction* Action = NewObject<UJackGetClientsAsyncAction>();
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UJackGetClientsAsyncAction::Activate()
+{
+	if (UUEJackAudioLinkSubsystem* Subsys = GetJackSubsystem())
+	{
+		CompleteOnGameThread(this, Subsys->GetConnectedClientsAsync());
+		return;
+	}
+	Complete(TArray<FString>());
+}
+
+void UJackGetClientsAsyncAction::Complete(const TArray<FString>& Clients)
+{
+	OnCompleted.Broadcast(Clients);
+	SetReadyToDestroy();
+}
+
+UJackGetClientPortsAsyncAction* UJackGetClientPortsAsyncAction::GetClientPortsAsync(UObject* WorldContextObject, const FString& ClientName)
+{
+	UJackGetClientPortsAsyncAction* Action = NewObject<UJackGetClientPortsAsyncAction>();
+	Action->QueryClientName = ClientName;
+	Action->RegisterWithGameInstance(WorldContextObject);
+	return Action;
+}
+
+void UJackGetClientPortsAsyncAction::Activate()
+{
+	if (UUEJackAudioLinkSubsystem* Subsys = GetJackSubsystem())
+	{
+		CompleteOnGameThread(this, Subsys->GetClientPortsAsync(QueryClientName));
+		return;
+	}
+	Complete(FJackClientPorts());
+}
+
+void UJackGetClientPortsAsyncAction::Complete(const FJackClientPorts& Ports)
+{
+	OnCompleted.Broadcast(Ports.InputPorts, Ports.OutputPorts);
+	SetReadyToDestroy();
+}
@@ -0,0 +1,647 @@
+#include "CoreMinimal.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "JackAudioRingBuffer.h"
+#include "JackClientManager.h"
+#include "JackSampleRateConverter.h"
+#include "UEJackAudioLinkLog.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#if PLATFORM_WINDOWS
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#if !UE_BUILD_SHIPPING
+
+// Reference copy of the previous per-sample ring kernel (modulo per sample), kept only
+// so the benchmark can report a before/after figure on the same machine.
+class FPerSampleRingBuffer
+{
+public:
+	FPerSampleRingBuffer(int32 InCapacity = 8192) : Capacity(InCapacity), WritePos(0), ReadPos(0)
+	{
+		Buffer.SetNumZeroed(Capacity);
+	}
+
+	void Write(const float* Data, int32 NumSamples)
+	{
+		const int32 Write = WritePos.load(std::memory_order_relaxed);
+		const int32 Read = ReadPos.load(std::memory_order_acquire);
+		const int32 ToWrite = FMath::Min(NumSamples, (Read - Write - 1 + Capacity) % Capacity);
+		int32 Pos = Write;
+		for (int32 i = 0; i < ToWrite; ++i)
+		{
+			Buffer[Pos] = Data[i];
+			Pos = (Pos + 1) % Capacity;
+		}
+		WritePos.store(Pos, std::memory_order_release);
+	}
+
+	int32 Read(float* OutData, int32 NumSamples)
+	{
+		const int32 Read = ReadPos.load(std::memory_order_relaxed);
+		const int32 Write = WritePos.load(std::memory_order_acquire);
+		const int32 SamplesRead = FMath::Min(NumSamples, (Write - Read + Capacity) % Capacity);
+		int32 Pos = Read;
+		for (int32 i = 0; i < SamplesRead; ++i)
+		{
+			OutData[i] = Buffer[Pos];
+			Pos = (Pos + 1) % Capacity;
+		}
+		ReadPos.store(Pos, std::memory_order_release);
+		for (int32 i = SamplesRead; i < NumSamples; ++i)
+		{
+			OutData[i] = 0.0f;
+		}
+		return SamplesRead;
+	}
+
+private:
+	TArray<float> Buffer;
+	int32 Capacity;
+	std::atomic<int32> WritePos;
+	std::atomic<int32> ReadPos;
+};
+
+// Reference copy of the ring layout before the producer/consumer split: both indices share one
+// cache line and every call loads the other side's index.
+// Out of line like the real ring's methods, so both pay the same call overhead.
+class FPackedIndexRingBuffer
+{
+public:
+	FPackedIndexRingBuffer(int32 InCapacity = 8192)
+		: Capacity(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 2)))), Mask(Capacity - 1)
+	{
+		Buffer.SetNumZeroed(Capacity);
+	}
+
+	FORCENOINLINE FJackAudioRingRegion PeekWrite(int32 MaxSamples)
+	{
+		const uint32 Write = WritePos.load(std::memory_order_relaxed);
+		const uint32 Read = ReadPos.load(std::memory_order_acquire);
+		return MakeRegion(Write, FMath::Min(static_cast<uint32>(MaxSamples), Capacity - (Write - Read)));
+	}
+
+	FORCENOINLINE void CommitWrite(int32 NumSamples)
+	{
+		const uint32 Write = WritePos.load(std::memory_order_relaxed);
+		const uint32 Read = ReadPos.load(std::memory_order_acquire);
+		WritePos.store(Write + FMath::Min(static_cast<uint32>(NumSamples), Capacity - (Write - Read)), std::memory_order_release);
+	}
+
+	FORCENOINLINE FJackAudioRingRegion PeekRead(int32 MaxSamples)
+	{
+		const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+		const uint32 Write = WritePos.load(std::memory_order_acquire);
+		return MakeRegion(Read, FMath::Min(static_cast<uint32>(MaxSamples), Write - Read));
+	}
+
+	FORCENOINLINE void CommitRead(int32 NumSamples)
+	{
+		const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+		const uint32 Write = WritePos.load(std::memory_order_acquire);
+		ReadPos.store(Read + FMath::Min(static_cast<uint32>(NumSamples), Write - Read), std::memory_order_release);
+	}
+
+private:
+	FJackAudioRingRegion MakeRegion(uint32 Position, uint32 Count)
+	{
+		const uint32 Start = Position & Mask;
+		const uint32 First = FMath::Min(Count, Capacity - Start);
+		FJackAudioRingRegion Region;
+		Region.First = TArrayView<float>(Buffer.GetData() + Start, First);
+		Region.Second = TArrayView<float>(Buffer.GetData(), Count - First);
+		return Region;
+	}
+
+	TArray<float> Buffer;
+	uint32 Capacity;
+	uint32 Mask;
+	std::atomic<uint32> WritePos{0};
+	std::atomic<uint32> ReadPos{0};
+};
+
+// Non-blocking transfer steps for the contention benchmark: move what fits, return how much that was
+template <typename RingType>
+static int32 TryWriteBlock(RingType& Ring, const float* Data, int32 NumSamples)
+{
+	const FJackAudioRingRegion Region = Ring.PeekWrite(NumSamples);
+	FMemory::Memcpy(Region.First.GetData(), Data, Region.First.Num() * sizeof(float));
+	FMemory::Memcpy(Region.Second.GetData(), Data + Region.First.Num(), Region.Second.Num() * sizeof(float));
+	Ring.CommitWrite(Region.Num());
+	return Region.Num();
+}
+
+template <typename RingType>
+static int32 TryReadBlock(RingType& Ring, float* OutData, int32 NumSamples)
+{
+	const FJackAudioRingRegion Region = Ring.PeekRead(NumSamples);
+	FMemory::Memcpy(OutData, Region.First.GetData(), Region.First.Num() * sizeof(float));
+	FMemory::Memcpy(OutData + Region.First.Num(), Region.Second.GetData(), Region.Second.Num() * sizeof(float));
+	Ring.CommitRead(Region.Num());
+	return Region.Num();
+}
+
+// Streams TotalSamples through one ring with the producer and consumer on two threads, both
+// polling as fast as they can, and returns the throughput in millions of samples per second.
+// With the data copies this small, the rate is bound by how often the two cores steal the
+// index cache lines from each other, so it stands in for the cross-core traffic.
+template <typename RingType>
+static double MeasureContendedThroughput(int32 BlockSize, int64 TotalSamples)
+{
+	RingType Ring(8192);
+	std::atomic<bool> bGo{false};
+
+	TFuture<void> Producer = Async(EAsyncExecution::Thread, [&Ring, &bGo, BlockSize, TotalSamples]()
+	{
+		TArray<float> Block;
+		Block.SetNumZeroed(BlockSize);
+		while (!bGo.load(std::memory_order_acquire))
+		{
+		}
+		int64 Written = 0;
+		int32 Misses = 0;
+		while (Written < TotalSamples)
+		{
+			const int32 Wanted = static_cast<int32>(FMath::Min<int64>(BlockSize, TotalSamples - Written));
+			const int32 Num = TryWriteBlock(Ring, Block.GetData(), Wanted);
+			Written += Num;
+			// Back off now and then so the benchmark also finishes on a single core
+			if (Num == 0 && ++Misses % 1024 == 0)
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+		}
+	});
+
+	TArray<float> Scratch;
+	Scratch.SetNumZeroed(BlockSize);
+	const uint64 Start = FPlatformTime::Cycles64();
+	bGo.store(true, std::memory_order_release);
+	int64 Read = 0;
+	int32 Misses = 0;
+	while (Read < TotalSamples)
+	{
+		const int32 Num = TryReadBlock(Ring, Scratch.GetData(), BlockSize);
+		Read += Num;
+		if (Num == 0 && ++Misses % 1024 == 0)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+	}
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+	Producer.Wait();
+	return Seconds > 0.0 ? TotalSamples / Seconds / 1.0e6 : 0.0;
+}
+
+// Simulates the ring work of one JACK cycle (every input ring written, every output ring read)
+// and returns the average time spent in that RT-side section, in nanoseconds per cycle.
+template <typename RingType>
+static double MeasureRingCycleNs(int32 NumChannels, int32 NumFrames, int32 NumCycles)
+{
+	TArray<TUniquePtr<RingType>> InputRings;
+	TArray<TUniquePtr<RingType>> OutputRings;
+	for (int32 i = 0; i < NumChannels; ++i)
+	{
+		InputRings.Add(MakeUnique<RingType>(8192));
+		OutputRings.Add(MakeUnique<RingType>(8192));
+	}
+
+	TArray<float> Block;
+	Block.SetNumUninitialized(NumFrames);
+	for (int32 i = 0; i < NumFrames; ++i)
+	{
+		Block[i] = FMath::Sin(2.0f * PI * 440.0f * i / 48000.0f);
+	}
+	TArray<float> Scratch;
+	Scratch.SetNumZeroed(NumFrames);
+
+	uint64 TotalCycles = 0;
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		// Game side (not timed): keep the outputs fed
+		for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+		{
+			OutputRings[Ch]->Write(Block.GetData(), NumFrames);
+		}
+
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+		{
+			InputRings[Ch]->Write(Block.GetData(), NumFrames);
+		}
+		for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+		{
+			OutputRings[Ch]->Read(Scratch.GetData(), NumFrames);
+		}
+		TotalCycles += FPlatformTime::Cycles64() - Start;
+
+		// Game side (not timed): drain the inputs
+		for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+		{
+			InputRings[Ch]->Read(Scratch.GetData(), NumFrames);
+		}
+	}
+	return FPlatformTime::ToMilliseconds64(TotalCycles) * 1.0e6 / FMath::Max(NumCycles, 1);
+}
+
+// Same cycle as above against one FMultichannelAudioRingBuffer per direction
+static double MeasureMultichannelRingCycleNs(int32 NumChannels, int32 NumFrames, int32 NumCycles)
+{
+	FMultichannelAudioRingBuffer InputRing(NumChannels, 8192);
+	FMultichannelAudioRingBuffer OutputRing(NumChannels, 8192);
+
+	// Stand-ins for the per-port JACK buffers
+	TArray<float> PortStorage;
+	PortStorage.SetNumUninitialized(NumChannels * NumFrames);
+	for (int32 i = 0; i < PortStorage.Num(); ++i)
+	{
+		PortStorage[i] = FMath::Sin(2.0f * PI * 440.0f * (i % NumFrames) / 48000.0f);
+	}
+	TArray<float*> PortBuffers;
+	for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+	{
+		PortBuffers.Add(PortStorage.GetData() + Ch * NumFrames);
+	}
+	TArray<float> Interleaved;
+	Interleaved.SetNumZeroed(NumChannels * NumFrames);
+
+	uint64 TotalCycles = 0;
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		OutputRing.WriteInterleaved(Interleaved.GetData(), NumFrames);
+
+		const uint64 Start = FPlatformTime::Cycles64();
+		InputRing.WritePlanar(PortBuffers.GetData(), NumFrames);
+		OutputRing.ReadPlanar(PortBuffers.GetData(), NumFrames);
+		TotalCycles += FPlatformTime::Cycles64() - Start;
+
+		InputRing.ReadInterleaved(Interleaved.GetData(), NumFrames);
+	}
+	return FPlatformTime::ToMilliseconds64(TotalCycles) * 1.0e6 / FMath::Max(NumCycles, 1);
+}
+
+// JackAudioLink.Bench.RingBuffer [Frames=64] [Cycles=10000]
+static void RunRingBufferBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumFrames = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 16, 4096) : 64;
+	const int32 NumCycles = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 10000;
+
+	UE_LOG(LogJackAudioLink, Display, TEXT("Ring buffer benchmark: %d frames/cycle, %d cycles (in + out rings per channel)"), NumFrames, NumCycles);
+	for (const int32 NumChannels : { 64, 128, 256 })
+	{
+		const double PerSampleNs = MeasureRingCycleNs<FPerSampleRingBuffer>(NumChannels, NumFrames, NumCycles);
+		const double BlockNs = MeasureRingCycleNs<FAudioRingBuffer>(NumChannels, NumFrames, NumCycles);
+		const double MultichannelNs = MeasureMultichannelRingCycleNs(NumChannels, NumFrames, NumCycles);
+		UE_LOG(LogJackAudioLink, Display, TEXT("  %3d channels: per-sample %9.0f ns/cycle, block copy %9.0f ns/cycle (x%.1f), multichannel ring %9.0f ns/cycle"),
+			NumChannels, PerSampleNs, BlockNs, BlockNs > 0.0 ? PerSampleNs / BlockNs : 0.0, MultichannelNs);
+	}
+}
+
+static FAutoConsoleCommand GJackRingBufferBenchmarkCommand(
+	TEXT("JackAudioLink.Bench.RingBuffer"),
+	TEXT("Measures the RT-side ring buffer cost of one JACK cycle for 64/128/256 channels. Args: [Frames=64] [Cycles=10000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunRingBufferBenchmark));
+
+// JackAudioLink.Bench.RingContention [Samples=64000000]
+static void RunRingContentionBenchmark(const TArray<FString>& Args)
+{
+	const int64 TotalSamples = Args.Num() > 0 ? FMath::Max<int64>(FCString::Atoi64(*Args[0]), 1) : 64000000;
+
+	UE_LOG(LogJackAudioLink, Display, TEXT("Ring contention benchmark: %lld samples, producer and consumer on separate threads"), TotalSamples);
+	for (const int32 BlockSize : { 1, 16, 64, 256 })
+	{
+		const double PackedRate = MeasureContendedThroughput<FPackedIndexRingBuffer>(BlockSize, TotalSamples);
+		const double SplitRate = MeasureContendedThroughput<FAudioRingBuffer>(BlockSize, TotalSamples);
+		UE_LOG(LogJackAudioLink, Display, TEXT("  %3d samples/transfer: shared index line %8.1f Msamples/s, split + cached indices %8.1f Msamples/s (x%.2f)"),
+			BlockSize, PackedRate, SplitRate, PackedRate > 0.0 ? SplitRate / PackedRate : 0.0);
+	}
+}
+
+static FAutoConsoleCommand GJackRingContentionBenchmarkCommand(
+	TEXT("JackAudioLink.Bench.RingContention"),
+	TEXT("Streams audio through one ring between two threads to compare the shared-line and split index layouts. Args: [Samples=64000000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunRingContentionBenchmark));
+
+// Time stamp counter where there is one (ticks at the nominal core clock on current x86), so per-sample costs
+// can be given in cycles; 0 elsewhere
+static uint64 ReadCpuCycles()
+{
+#if PLATFORM_CPU_X86_FAMILY
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+struct FSampleRateConverterBenchmarkResult
+{
+	double CyclesPerSample = 0.0;
+	double NsPerSample = 0.0;
+};
+
+// Converts NumCycles JACK periods of NumFrames on NumChannels planar channels. bToJack runs the output
+// direction (exactly NumFrames out of each block), otherwise the input one (NumFrames in); costs are per
+// channel-sample on the JACK side.
+static FSampleRateConverterBenchmarkResult MeasureSampleRateConverter(uint32 InputRate, uint32 OutputRate, bool bToJack, int32 NumChannels, int32 NumFrames, int32 NumCycles)
+{
+	FSampleRateConverterBenchmarkResult Result;
+	const uint32 GameRate = bToJack ? InputRate : OutputRate;
+	const uint32 JackRate = bToJack ? OutputRate : InputRate;
+	const int32 MaxInputFrames = bToJack ? static_cast<int32>(static_cast<int64>(NumFrames) * GameRate / JackRate) + 2 : NumFrames;
+	FJackSampleRateConverter Converter;
+	if (!Converter.Init(InputRate, OutputRate, NumChannels, MaxInputFrames))
+	{
+		return Result;
+	}
+	const int32 Stride = FMath::Max(MaxInputFrames, Converter.GetMaxOutputFrames(MaxInputFrames));
+	TArray<float> Input;
+	TArray<float> Output;
+	Input.SetNumUninitialized(NumChannels * Stride);
+	Output.SetNumZeroed(NumChannels * Stride);
+	for (int32 i = 0; i < Input.Num(); ++i)
+	{
+		Input[i] = FMath::Sin(2.0f * PI * 1000.0f * (i % Stride) / InputRate);
+	}
+
+	int64 NumJackSamples = 0;
+	const uint64 StartCycles = ReadCpuCycles();
+	const uint64 StartTime = FPlatformTime::Cycles64();
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		const int32 NumInput = bToJack ? FMath::Min(Converter.GetInputFramesNeeded(NumFrames), MaxInputFrames) : NumFrames;
+		Converter.Plan(NumInput, bToJack ? NumFrames : Stride);
+		for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+		{
+			Converter.ProcessChannel(Ch, Input.GetData() + Ch * Stride, Output.GetData() + Ch * Stride);
+		}
+		Converter.Commit();
+		NumJackSamples += static_cast<int64>(NumFrames) * NumChannels;
+	}
+	const uint64 ElapsedCycles = ReadCpuCycles() - StartCycles;
+	const double ElapsedNs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartTime) * 1.0e6;
+	Result.CyclesPerSample = static_cast<double>(ElapsedCycles) / FMath::Max<int64>(NumJackSamples, 1);
+	Result.NsPerSample = ElapsedNs / FMath::Max<int64>(NumJackSamples, 1);
+	return Result;
+}
+
+// JackAudioLink.Bench.SampleRateConverter [Frames=256] [Cycles=2000] [Channels=64]
+static void RunSampleRateConverterBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumFrames = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 16, 4096) : 256;
+	const int32 NumCycles = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 10) : 2000;
+	const int32 NumChannels = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, 256) : 64;
+
+	UE_LOG(LogJackAudioLink, Display, TEXT("Sample rate converter benchmark: %d channels, %d-frame JACK periods, %d periods, %d taps per phase"),
+		NumChannels, NumFrames, NumCycles, FJackSampleRateConverter::NumTaps);
+	UE_LOG(LogJackAudioLink, Display, TEXT("  game Hz  JACK Hz  direction       cycles/sample  ns/sample  %% of one core at the JACK rate"));
+	const uint32 Rates[][2] = { { 44100, 48000 }, { 48000, 96000 } };
+	for (const auto& Pair : Rates)
+	{
+		for (const bool bToJack : { true, false })
+		{
+			// Game-side rate first: 44.1 kHz content against a 48 kHz server, 48 kHz against 96 kHz
+			const uint32 GameRate = Pair[0];
+			const uint32 JackRate = Pair[1];
+			const FSampleRateConverterBenchmarkResult Result = bToJack
+				? MeasureSampleRateConverter(GameRate, JackRate, true, NumChannels, NumFrames, NumCycles)
+				: MeasureSampleRateConverter(JackRate, GameRate, false, NumChannels, NumFrames, NumCycles);
+			const double CorePercent = 100.0 * Result.NsPerSample * NumChannels * JackRate / 1.0e9;
+			UE_LOG(LogJackAudioLink, Display, TEXT("  %7u  %7u  %-14s  %13.1f  %9.2f  %6.2f"),
+				GameRate, JackRate, bToJack ? TEXT("out (to JACK)") : TEXT("in (from JACK)"), Result.CyclesPerSample, Result.NsPerSample, CorePercent);
+		}
+	}
+#if !PLATFORM_CPU_X86_FAMILY
+	UE_LOG(LogJackAudioLink, Display, TEXT("  (no time stamp counter on this CPU: cycles/sample reads 0, use ns/sample)"));
+#endif
+}
+
+static FAutoConsoleCommand GJackSampleRateConverterBenchmarkCommand(
+	TEXT("JackAudioLink.Bench.SampleRateConverter"),
+	TEXT("Measures the polyphase converter per JACK-side channel-sample at 44.1->48 kHz and 48->96 kHz, both directions. Args: [Frames=256] [Cycles=2000] [Channels=64]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunSampleRateConverterBenchmark));
+
+// Counts heap allocations made by threads that opted in and forwards everything to the real allocator.
+// Installed over GMalloc only while a benchmark runs; never destroyed, since other threads may still
+// hold the pointer for a moment after it is swapped back out.
+class FJackCountingMalloc final : public FMalloc
+{
+public:
+	static FJackCountingMalloc& Get()
+	{
+		static FJackCountingMalloc* Instance = new FJackCountingMalloc();
+		return *Instance;
+	}
+
+	// Re-installable, so every benchmark run counts. GMalloc being this (not Inner) marks it as installed:
+	// Inner stays set after Uninstall for callers that still hold the pointer.
+	void Install()
+	{
+		check(IsInGameThread() && GMalloc != this);
+		Inner = GMalloc;
+		GMalloc = this;
+	}
+
+	void Uninstall()
+	{
+		check(IsInGameThread() && GMalloc == this);
+		GMalloc = Inner;
+	}
+
+	static void SetCountingOnThisThread(bool bEnable) { bCountOnThisThread = bEnable; }
+	uint64 GetNumAllocations() const { return NumAllocations.load(std::memory_order_relaxed); }
+
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override { NoteAllocation(); return Inner->Malloc(Count, Alignment); }
+	virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override { NoteAllocation(); return Inner->TryMalloc(Count, Alignment); }
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override { NoteAllocation(); return Inner->Realloc(Original, Count, Alignment); }
+	virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override { NoteAllocation(); return Inner->TryRealloc(Original, Count, Alignment); }
+	virtual void Free(void* Original) override { Inner->Free(Original); }
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual const TCHAR* GetDescriptiveName() override { return TEXT("JackCountingMalloc"); }
+
+private:
+	void NoteAllocation()
+	{
+		if (bCountOnThisThread)
+		{
+			NumAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	FMalloc* Inner = nullptr;
+	std::atomic<uint64> NumAllocations{0};
+	static thread_local bool bCountOnThisThread;
+};
+
+thread_local bool FJackCountingMalloc::bCountOnThisThread = false;
+
+#if WITH_JACK
+// Fake ports for driving FJackClientManager::ProcessPortSet without a server: the "port" is the
+// address of its sample buffer, so the buffer lookup is as cheap as a real one
+static void* GetBenchmarkPortBuffer(jack_port_t* Port, jack_nframes_t /*NumFrames*/)
+{
+	return Port;
+}
+
+static TSharedRef<FJackPortSet> MakeBenchmarkPortSet(int32 NumChannels, int32 NumFrames, bool bUseMultichannelRing, TArray<float>& PortStorage)
+{
+	PortStorage.SetNumUninitialized(2 * NumChannels * NumFrames);
+	for (int32 i = 0; i < PortStorage.Num(); ++i)
+	{
+		PortStorage[i] = FMath::Sin(2.0f * PI * 440.0f * (i % NumFrames) / 48000.0f);
+	}
+
+	const int32 RingCapacity = FMath::Max(8192, NumFrames * 4);
+	TSharedRef<FJackPortSet> PortSet = MakeShared<FJackPortSet>();
+	PortSet->bUseMultichannelRing = bUseMultichannelRing;
+	for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+	{
+		PortSet->InputPorts.Add(reinterpret_cast<jack_port_t*>(PortStorage.GetData() + Ch * NumFrames));
+		PortSet->OutputPorts.Add(reinterpret_cast<jack_port_t*>(PortStorage.GetData() + (NumChannels + Ch) * NumFrames));
+		PortSet->InputMeters.Add(MakeShared<FJackChannelMeter>());
+		PortSet->InputConnections.Add(MakeShared<FJackPortConnection>());
+		PortSet->OutputConnections.Add(MakeShared<FJackPortConnection>());
+		PortSet->InputConnections.Last()->bConnected = true;
+		PortSet->OutputConnections.Last()->bConnected = true;
+		if (!bUseMultichannelRing)
+		{
+			PortSet->InputRingBuffers.Add(MakeShared<FAudioRingBuffer>(RingCapacity));
+			PortSet->OutputRingBuffers.Add(MakeShared<FAudioRingBuffer>(RingCapacity));
+		}
+	}
+	if (bUseMultichannelRing)
+	{
+		PortSet->InputBlockRing = MakeShared<FMultichannelAudioRingBuffer>(NumChannels, RingCapacity);
+		PortSet->OutputBlockRing = MakeShared<FMultichannelAudioRingBuffer>(NumChannels, RingCapacity);
+		PortSet->InputPortBuffers.SetNumZeroed(NumChannels);
+		PortSet->OutputPortBuffers.SetNumZeroed(NumChannels);
+	}
+	return PortSet;
+}
+
+struct FProcessBenchmarkResult
+{
+	double MeanNs = 0.0;
+	double P99Ns = 0.0;
+	double P999Ns = 0.0;
+	uint64 Allocations = 0;
+};
+
+// Runs NumCycles process cycles back to back on the calling thread while a second thread plays the
+// game side (drains every input, refills every output), and times each cycle individually
+static FProcessBenchmarkResult MeasureProcessCycles(int32 NumChannels, int32 NumFrames, bool bUseMultichannelRing, int32 NumCycles)
+{
+	TArray<float> PortStorage;
+	const TSharedRef<FJackPortSet> PortSet = MakeBenchmarkPortSet(NumChannels, NumFrames, bUseMultichannelRing, PortStorage);
+	const FJackMeterCoefficients MeterCoefficients = FJackMeterCoefficients::Make(NumFrames, 48000, 0.3f, 20.0f);
+
+	std::atomic<bool> bStop{false};
+	TFuture<void> Consumer = Async(EAsyncExecution::Thread, [PortSet, NumChannels, NumFrames, &bStop]()
+	{
+		TArray<float> Scratch;
+		Scratch.SetNumZeroed(NumChannels * NumFrames);
+		while (!bStop.load(std::memory_order_relaxed))
+		{
+			int32 Moved = 0;
+			if (PortSet->bUseMultichannelRing)
+			{
+				Moved += PortSet->InputBlockRing->ReadInterleaved(Scratch.GetData(), NumFrames);
+				PortSet->OutputBlockRing->WriteInterleaved(Scratch.GetData(), NumFrames);
+			}
+			else
+			{
+				for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+				{
+					Moved += PortSet->InputRingBuffers[Ch]->Read(Scratch.GetData(), NumFrames);
+					PortSet->OutputRingBuffers[Ch]->Write(Scratch.GetData(), NumFrames);
+				}
+			}
+			if (Moved == 0)
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+		}
+	});
+
+	TArray<uint64> CycleTimes;
+	CycleTimes.SetNumUninitialized(NumCycles);
+	FJackCountingMalloc& CountingMalloc = FJackCountingMalloc::Get();
+	const uint64 AllocationsBefore = CountingMalloc.GetNumAllocations();
+	FJackCountingMalloc::SetCountingOnThisThread(true);
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		const uint64 Start = FPlatformTime::Cycles64();
+		FJackClientManager::ProcessPortSet(*PortSet, NumFrames, MeterCoefficients, &GetBenchmarkPortBuffer);
+		CycleTimes[Cycle] = FPlatformTime::Cycles64() - Start;
+	}
+	FJackCountingMalloc::SetCountingOnThisThread(false);
+
+	FProcessBenchmarkResult Result;
+	Result.Allocations = CountingMalloc.GetNumAllocations() - AllocationsBefore;
+	bStop.store(true, std::memory_order_relaxed);
+	Consumer.Wait();
+
+	uint64 Total = 0;
+	for (const uint64 Time : CycleTimes)
+	{
+		Total += Time;
+	}
+	CycleTimes.Sort();
+	auto ToNs = [](uint64 Cycles) { return FPlatformTime::ToMilliseconds64(Cycles) * 1.0e6; };
+	Result.MeanNs = ToNs(Total) / FMath::Max(NumCycles, 1);
+	Result.P99Ns = ToNs(CycleTimes[FMath::Min(NumCycles - 1, static_cast<int32>(NumCycles * 0.99))]);
+	Result.P999Ns = ToNs(CycleTimes[FMath::Min(NumCycles - 1, static_cast<int32>(NumCycles * 0.999))]);
+	return Result;
+}
+
+// JackAudioLink.Bench.Process [Cycles=2000]
+static void RunProcessBenchmark(const TArray<FString>& Args)
+{
+	const int32 NumCycles = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 10) : 2000;
+
+	UE_LOG(LogJackAudioLink, Display, TEXT("Process callback benchmark: %d cycles per case, all ports connected, concurrent consumer thread"), NumCycles);
+	UE_LOG(LogJackAudioLink, Display, TEXT("  mode          ch  frames      mean ns       p99 ns     p99.9 ns  p99.9 %%budget@48k  allocs"));
+
+	double WorstBudgetPercent = 0.0;
+	FString WorstCase;
+	FJackCountingMalloc::Get().Install();
+	for (const bool bUseMultichannelRing : { false, true })
+	{
+		for (const int32 NumChannels : { 2, 8, 32, 64, 128, 256 })
+		{
+			for (const int32 NumFrames : { 16, 64, 256, 1024, 4096 })
+			{
+				const FProcessBenchmarkResult Result = MeasureProcessCycles(NumChannels, NumFrames, bUseMultichannelRing, NumCycles);
+				const double BudgetNs = NumFrames * 1.0e9 / 48000.0;
+				const double BudgetPercent = 100.0 * Result.P999Ns / BudgetNs;
+				const TCHAR* Mode = bUseMultichannelRing ? TEXT("multichannel") : TEXT("per-port");
+				UE_LOG(LogJackAudioLink, Display, TEXT("  %-12s %3d  %6d  %11.0f  %11.0f  %11.0f  %17.2f  %6llu"),
+					Mode, NumChannels, NumFrames, Result.MeanNs, Result.P99Ns, Result.P999Ns, BudgetPercent, Result.Allocations);
+				if (BudgetPercent > WorstBudgetPercent)
+				{
+					WorstBudgetPercent = BudgetPercent;
+					WorstCase = FString::Printf(TEXT("%s, %d ch, %d frames"), Mode, NumChannels, NumFrames);
+				}
+			}
+		}
+	}
+	FJackCountingMalloc::Get().Uninstall();
+	UE_LOG(LogJackAudioLink, Display, TEXT("Worst p99.9 cycle: %.2f%% of the 48 kHz budget (%s)"), WorstBudgetPercent, *WorstCase);
+}
+
+static FAutoConsoleCommand GJackProcessBenchmarkCommand(
+	TEXT("JackAudioLink.Bench.Process"),
+	TEXT("Times the process callback body on fake ports for 2-256 channels and 16-4096 frames with a concurrent consumer; reports mean/p99/p99.9 and RT-side allocations. Args: [Cycles=2000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&RunProcessBenchmark));
+#endif // WITH_JACK
+
+#endif // !UE_BUILD_SHIPPING
@@ -1,6 +1,7 @@
 #include "JackAudioLinkSettings.h"
 #include "Misc/App.h"
 #include "UEJackAudioLinkLog.h"
+#include "JackClientManager.h"
 
 UJackAudioLinkSettings::UJackAudioLinkSettings(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -102,10 +103,28 @@ int32 UJackAudioLinkSettings::GetBufferSizeValue() const
     }
 }
 
+void UJackAudioLinkSettings::ApplyMeteringSettings() const
+{
+#if WITH_JACK
+    FJackClientManager::Get().SetMeteringParameters(MeterIntegrationWindowMs / 1000.0f, MeterPeakDecayDbPerSecond);
+    FJackClientManager::Get().SetCallbackBudgetThreshold(CallbackBudgetThresholdPercent / 100.0f);
+#endif
+}
+
+void UJackAudioLinkSettings::ApplySampleRateConversionSettings() const
+{
+#if WITH_JACK
+    FJackClientManager::Get().SetSampleRateConversion(true, static_cast<uint32>(FMath::Max(InputRingSampleRate, 0)));
+    FJackClientManager::Get().SetSampleRateConversion(false, static_cast<uint32>(FMath::Max(OutputRingSampleRate, 0)));
+#endif
+}
+
 #if WITH_EDITOR
 void UJackAudioLinkSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
 {
     Super::PostEditChangeProperty(PropertyChangedEvent);
     UE_LOG(LogJackAudioLink, Display, TEXT("JackAudioLinkSettings changed"));
+    ApplyMeteringSettings();
+    ApplySampleRateConversionSettings();
 }
 #endif 
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "JackAudioMeter.h"
+#include "Math/VectorRegister.h"
+
+void JackComputeBlockLevels(const float* Samples, int32 NumSamples, float& OutSumSquares, float& OutPeak)
+{
+	VectorRegister4Float SumSquares = VectorZeroFloat();
+	VectorRegister4Float PeakAbs = VectorZeroFloat();
+	int32 i = 0;
+	for (; i + 4 <= NumSamples; i += 4)
+	{
+		const VectorRegister4Float V = VectorLoad(Samples + i);
+		SumSquares = VectorMultiplyAdd(V, V, SumSquares);
+		PeakAbs = VectorMax(PeakAbs, VectorAbs(V));
+	}
+
+	alignas(16) float SumLanes[4];
+	alignas(16) float PeakLanes[4];
+	VectorStoreAligned(SumSquares, SumLanes);
+	VectorStoreAligned(PeakAbs, PeakLanes);
+	float Sum = (SumLanes[0] + SumLanes[1]) + (SumLanes[2] + SumLanes[3]);
+	float Peak = FMath::Max(FMath::Max(PeakLanes[0], PeakLanes[1]), FMath::Max(PeakLanes[2], PeakLanes[3]));
+
+	// Tail (JACK block sizes are powers of two, so normally empty)
+	for (; i < NumSamples; ++i)
+	{
+		Sum += Samples[i] * Samples[i];
+		Peak = FMath::Max(Peak, FMath::Abs(Samples[i]));
+	}
+	OutSumSquares = Sum;
+	OutPeak = Peak;
+}
+
+FJackMeterCoefficients FJackMeterCoefficients::Make(int32 NumFrames, uint32 SampleRate, float IntegrationWindowSeconds, float PeakDecayDbPerSecond)
+{
+	FJackMeterCoefficients Result;
+	if (NumFrames <= 0 || SampleRate == 0)
+	{
+		return Result;
+	}
+	const float BlockSeconds = static_cast<float>(NumFrames) / static_cast<float>(SampleRate);
+	// One-pole average whose time constant is the integration window
+	Result.RMSCoefficient = IntegrationWindowSeconds > 0.0f ? 1.0f - FMath::Exp(-BlockSeconds / IntegrationWindowSeconds) : 1.0f;
+	// Linear fall in dB while no louder block arrives
+	Result.PeakDecay = FMath::Pow(10.0f, -FMath::Max(PeakDecayDbPerSecond, 0.0f) * BlockSeconds / 20.0f);
+	return Result;
+}
+
+void FJackChannelMeter::Update(const float* Samples, int32 NumFrames, const FJackMeterCoefficients& Coefficients)
+{
+	if (!Samples || NumFrames <= 0)
+	{
+		return;
+	}
+	float SumSquares = 0.0f;
+	float BlockPeak = 0.0f;
+	JackComputeBlockLevels(Samples, NumFrames, SumSquares, BlockPeak);
+
+	MeanSquare += Coefficients.RMSCoefficient * (SumSquares / NumFrames - MeanSquare);
+	Peak = FMath::Max(BlockPeak, Peak * Coefficients.PeakDecay);
+	// Keep the decaying state out of denormals on the RT thread
+	if (MeanSquare < 1.0e-20f)
+	{
+		MeanSquare = 0.0f;
+	}
+	if (Peak < 1.0e-10f)
+	{
+		Peak = 0.0f;
+	}
+
+	PublishedRMS.store(FMath::Sqrt(MeanSquare), std::memory_order_relaxed);
+	PublishedPeak.store(Peak, std::memory_order_relaxed);
+}
+
+void FJackChannelMeter::Clear()
+{
+	if (Peak == 0.0f && MeanSquare == 0.0f)
+	{
+		return;
+	}
+	MeanSquare = 0.0f;
+	Peak = 0.0f;
+	PublishedRMS.store(0.0f, std::memory_order_relaxed);
+	PublishedPeak.store(0.0f, std::memory_order_relaxed);
+}
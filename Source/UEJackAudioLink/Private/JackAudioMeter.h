@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// Sum of squares and absolute peak of a block of samples (SIMD, four lanes at a time)
+void JackComputeBlockLevels(const float* Samples, int32 NumSamples, float& OutSumSquares, float& OutPeak);
+
+// Per-cycle smoothing factors derived from the metering settings for a given block size and sample rate
+struct FJackMeterCoefficients
+{
+	float RMSCoefficient = 1.0f; // Weight of the new block in the exponential mean-square average
+	float PeakDecay = 0.0f;      // Gain applied to the held peak each block
+
+	static FJackMeterCoefficients Make(int32 NumFrames, uint32 SampleRate, float IntegrationWindowSeconds, float PeakDecayDbPerSecond);
+};
+
+// RMS/peak meter for one channel. Update is called from the JACK process thread only; the levels
+// are published through atomics so readers on any thread get a lock-free load.
+class FJackChannelMeter
+{
+public:
+	void Update(const float* Samples, int32 NumFrames, const FJackMeterCoefficients& Coefficients);
+	// Drops the meter to zero, e.g. while its port is disconnected (process thread only)
+	void Clear();
+
+	float GetRMS() const { return PublishedRMS.load(std::memory_order_relaxed); }
+	float GetPeak() const { return PublishedPeak.load(std::memory_order_relaxed); }
+
+private:
+	// RT-owned running state
+	float MeanSquare = 0.0f;
+	float Peak = 0.0f;
+
+	std::atomic<float> PublishedRMS{0.0f};
+	std::atomic<float> PublishedPeak{0.0f};
+};
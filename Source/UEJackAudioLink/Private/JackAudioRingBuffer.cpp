@@ -0,0 +1,295 @@
+#include "JackAudioRingBuffer.h"
+
+// FAudioRingBuffer implementation
+void FAudioRingBuffer::Write(const float* Data, int32 NumSamples)
+{
+    if (NumSamples <= 0) { return; }
+    // Only the producer stores WritePos, so a relaxed load of our own index is enough;
+    // acquire on ReadPos makes sure the consumer is done with the slots we are about to reuse.
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 Free = GetFreeForProducer(Write, NumSamples);
+    const uint32 ToWrite = FMath::Min(static_cast<uint32>(NumSamples), Free);
+
+    // At most two segments: up to the end of the storage, then from its start
+    const uint32 Start = Write & Mask;
+    const uint32 First = FMath::Min(ToWrite, Capacity - Start);
+    if (Data)
+    {
+        FMemory::Memcpy(Buffer.GetData() + Start, Data, First * sizeof(float));
+        FMemory::Memcpy(Buffer.GetData(), Data + First, (ToWrite - First) * sizeof(float));
+    }
+    else
+    {
+        FMemory::Memzero(Buffer.GetData() + Start, First * sizeof(float));
+        FMemory::Memzero(Buffer.GetData(), (ToWrite - First) * sizeof(float));
+    }
+
+    // Publish the samples to the consumer
+    WritePos.store(Write + ToWrite, std::memory_order_release);
+
+    if (ToWrite < static_cast<uint32>(NumSamples))
+    {
+        DroppedSamples.fetch_add(static_cast<uint64>(NumSamples) - ToWrite, std::memory_order_relaxed);
+    }
+}
+
+int32 FAudioRingBuffer::Read(float* OutData, int32 NumSamples)
+{
+    if (NumSamples <= 0) { return 0; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 SamplesRead = FMath::Min(static_cast<uint32>(NumSamples), GetReadableForConsumer(Read, NumSamples));
+
+    const uint32 Start = Read & Mask;
+    const uint32 First = FMath::Min(SamplesRead, Capacity - Start);
+    FMemory::Memcpy(OutData, Buffer.GetData() + Start, First * sizeof(float));
+    FMemory::Memcpy(OutData + First, Buffer.GetData(), (SamplesRead - First) * sizeof(float));
+
+    // Hand the slots back to the producer
+    ReadPos.store(Read + SamplesRead, std::memory_order_release);
+
+    // Zero remaining samples if requested more than available
+    if (SamplesRead < static_cast<uint32>(NumSamples))
+    {
+        FMemory::Memzero(OutData + SamplesRead, (NumSamples - SamplesRead) * sizeof(float));
+    }
+    return static_cast<int32>(SamplesRead);
+}
+
+int32 FAudioRingBuffer::Discard(int32 NumSamples)
+{
+    if (NumSamples <= 0) { return 0; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 Dropped = FMath::Min(static_cast<uint32>(NumSamples), GetReadableForConsumer(Read, NumSamples));
+    ReadPos.store(Read + Dropped, std::memory_order_release);
+    return static_cast<int32>(Dropped);
+}
+
+FJackAudioRingRegion FAudioRingBuffer::PeekRead(int32 MaxSamples)
+{
+    FJackAudioRingRegion Region;
+    if (MaxSamples <= 0) { return Region; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 Count = FMath::Min(static_cast<uint32>(MaxSamples), GetReadableForConsumer(Read, MaxSamples));
+    const uint32 Start = Read & Mask;
+    const uint32 First = FMath::Min(Count, Capacity - Start);
+    Region.First = TArrayView<float>(Buffer.GetData() + Start, First);
+    Region.Second = TArrayView<float>(Buffer.GetData(), Count - First);
+    return Region;
+}
+
+void FAudioRingBuffer::CommitRead(int32 NumSamples)
+{
+    // Never move past what the producer has published
+    Discard(NumSamples);
+}
+
+FJackAudioRingRegion FAudioRingBuffer::PeekWrite(int32 MaxSamples)
+{
+    FJackAudioRingRegion Region;
+    if (MaxSamples <= 0) { return Region; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 Count = FMath::Min(static_cast<uint32>(MaxSamples), GetFreeForProducer(Write, MaxSamples));
+    const uint32 Start = Write & Mask;
+    const uint32 First = FMath::Min(Count, Capacity - Start);
+    Region.First = TArrayView<float>(Buffer.GetData() + Start, First);
+    Region.Second = TArrayView<float>(Buffer.GetData(), Count - First);
+    return Region;
+}
+
+void FAudioRingBuffer::CommitWrite(int32 NumSamples)
+{
+    if (NumSamples <= 0) { return; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 Count = FMath::Min(static_cast<uint32>(NumSamples), GetFreeForProducer(Write, NumSamples));
+    WritePos.store(Write + Count, std::memory_order_release);
+}
+
+void FAudioRingBuffer::Clear()
+{
+    CachedWritePos = WritePos.load(std::memory_order_acquire);
+    ReadPos.store(CachedWritePos, std::memory_order_release);
+}
+
+int32 FAudioRingBuffer::GetAvailableRead() const
+{
+    // Also called from threads that are neither side (latency reporting). Loading ReadPos first means
+    // WritePos can only be newer, never behind it; a producer that ran ahead in between can still
+    // make the gap look larger than the ring, hence the clamp.
+    const uint32 Read = ReadPos.load(std::memory_order_acquire);
+    const uint32 Write = WritePos.load(std::memory_order_acquire);
+    return FMath::Clamp(static_cast<int32>(Write - Read), 0, static_cast<int32>(Capacity));
+}
+
+int32 FAudioRingBuffer::GetAvailableWrite() const
+{
+    return static_cast<int32>(Capacity) - GetAvailableRead();
+}
+
+// FMultichannelAudioRingBuffer implementation
+FMultichannelAudioRingBuffer::FMultichannelAudioRingBuffer(int32 InNumChannels, int32 InCapacityFrames)
+    : NumChannels(static_cast<uint32>(FMath::Max(InNumChannels, 1)))
+    , Capacity(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacityFrames, 16))))
+    , Mask(Capacity - 1)
+{
+    Arena.SetNumZeroed(static_cast<int32>(Capacity * NumChannels));
+}
+
+void FMultichannelAudioRingBuffer::WritePlanar(const float* const* ChannelData, int32 NumFrames)
+{
+    if (NumFrames <= 0) { return; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 ToWrite = FMath::Min(static_cast<uint32>(NumFrames), GetFreeForProducer(Write, NumFrames));
+
+    // Two contiguous frame segments at most; within a segment each channel is a strided scatter
+    const uint32 Start = Write & Mask;
+    const uint32 First = FMath::Min(ToWrite, Capacity - Start);
+    for (uint32 Ch = 0; Ch < NumChannels; ++Ch)
+    {
+        const float* Src = ChannelData[Ch];
+        float* Dst = Arena.GetData() + Start * NumChannels + Ch;
+        for (uint32 i = 0; i < First; ++i)
+        {
+            Dst[i * NumChannels] = Src ? Src[i] : 0.0f;
+        }
+        Dst = Arena.GetData() + Ch;
+        for (uint32 i = First; i < ToWrite; ++i)
+        {
+            Dst[(i - First) * NumChannels] = Src ? Src[i] : 0.0f;
+        }
+    }
+
+    WritePos.store(Write + ToWrite, std::memory_order_release);
+    if (ToWrite < static_cast<uint32>(NumFrames))
+    {
+        DroppedFrames.fetch_add(static_cast<uint64>(NumFrames) - ToWrite, std::memory_order_relaxed);
+    }
+}
+
+void FMultichannelAudioRingBuffer::WriteInterleaved(const float* Frames, int32 NumFrames)
+{
+    if (NumFrames <= 0) { return; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 ToWrite = FMath::Min(static_cast<uint32>(NumFrames), GetFreeForProducer(Write, NumFrames));
+
+    const uint32 Start = Write & Mask;
+    const uint32 First = FMath::Min(ToWrite, Capacity - Start);
+    FMemory::Memcpy(FrameAt(Write), Frames, First * NumChannels * sizeof(float));
+    FMemory::Memcpy(Arena.GetData(), Frames + First * NumChannels, (ToWrite - First) * NumChannels * sizeof(float));
+
+    WritePos.store(Write + ToWrite, std::memory_order_release);
+    if (ToWrite < static_cast<uint32>(NumFrames))
+    {
+        DroppedFrames.fetch_add(static_cast<uint64>(NumFrames) - ToWrite, std::memory_order_relaxed);
+    }
+}
+
+int32 FMultichannelAudioRingBuffer::ReadPlanar(float* const* OutChannels, int32 NumFrames)
+{
+    if (NumFrames <= 0) { return 0; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 FramesRead = FMath::Min(static_cast<uint32>(NumFrames), GetReadableForConsumer(Read, NumFrames));
+
+    const uint32 Start = Read & Mask;
+    const uint32 First = FMath::Min(FramesRead, Capacity - Start);
+    for (uint32 Ch = 0; Ch < NumChannels; ++Ch)
+    {
+        float* Dst = OutChannels[Ch];
+        if (!Dst)
+        {
+            continue;
+        }
+        const float* Src = Arena.GetData() + Start * NumChannels + Ch;
+        for (uint32 i = 0; i < First; ++i)
+        {
+            Dst[i] = Src[i * NumChannels];
+        }
+        Src = Arena.GetData() + Ch;
+        for (uint32 i = First; i < FramesRead; ++i)
+        {
+            Dst[i] = Src[(i - First) * NumChannels];
+        }
+        if (FramesRead < static_cast<uint32>(NumFrames))
+        {
+            FMemory::Memzero(Dst + FramesRead, (NumFrames - FramesRead) * sizeof(float));
+        }
+    }
+
+    ReadPos.store(Read + FramesRead, std::memory_order_release);
+    return static_cast<int32>(FramesRead);
+}
+
+int32 FMultichannelAudioRingBuffer::ReadInterleaved(float* OutFrames, int32 NumFrames)
+{
+    if (NumFrames <= 0) { return 0; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 FramesRead = FMath::Min(static_cast<uint32>(NumFrames), GetReadableForConsumer(Read, NumFrames));
+
+    const uint32 Start = Read & Mask;
+    const uint32 First = FMath::Min(FramesRead, Capacity - Start);
+    FMemory::Memcpy(OutFrames, FrameAt(Read), First * NumChannels * sizeof(float));
+    FMemory::Memcpy(OutFrames + First * NumChannels, Arena.GetData(), (FramesRead - First) * NumChannels * sizeof(float));
+
+    ReadPos.store(Read + FramesRead, std::memory_order_release);
+    if (FramesRead < static_cast<uint32>(NumFrames))
+    {
+        FMemory::Memzero(OutFrames + FramesRead * NumChannels, (NumFrames - FramesRead) * NumChannels * sizeof(float));
+    }
+    return static_cast<int32>(FramesRead);
+}
+
+FJackAudioRingRegion FMultichannelAudioRingBuffer::PeekReadFrames(int32 MaxFrames)
+{
+    FJackAudioRingRegion Region;
+    if (MaxFrames <= 0) { return Region; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    const uint32 Count = FMath::Min(static_cast<uint32>(MaxFrames), GetReadableForConsumer(Read, MaxFrames));
+    const uint32 First = FMath::Min(Count, Capacity - (Read & Mask));
+    Region.First = TArrayView<float>(FrameAt(Read), First * NumChannels);
+    Region.Second = TArrayView<float>(Arena.GetData(), (Count - First) * NumChannels);
+    return Region;
+}
+
+void FMultichannelAudioRingBuffer::CommitReadFrames(int32 NumFrames)
+{
+    if (NumFrames <= 0) { return; }
+    const uint32 Read = ReadPos.load(std::memory_order_relaxed);
+    ReadPos.store(Read + FMath::Min(static_cast<uint32>(NumFrames), GetReadableForConsumer(Read, NumFrames)), std::memory_order_release);
+}
+
+FJackAudioRingRegion FMultichannelAudioRingBuffer::PeekWriteFrames(int32 MaxFrames)
+{
+    FJackAudioRingRegion Region;
+    if (MaxFrames <= 0) { return Region; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    const uint32 Count = FMath::Min(static_cast<uint32>(MaxFrames), GetFreeForProducer(Write, MaxFrames));
+    const uint32 First = FMath::Min(Count, Capacity - (Write & Mask));
+    Region.First = TArrayView<float>(FrameAt(Write), First * NumChannels);
+    Region.Second = TArrayView<float>(Arena.GetData(), (Count - First) * NumChannels);
+    return Region;
+}
+
+void FMultichannelAudioRingBuffer::CommitWriteFrames(int32 NumFrames)
+{
+    if (NumFrames <= 0) { return; }
+    const uint32 Write = WritePos.load(std::memory_order_relaxed);
+    WritePos.store(Write + FMath::Min(static_cast<uint32>(NumFrames), GetFreeForProducer(Write, NumFrames)), std::memory_order_release);
+}
+
+void FMultichannelAudioRingBuffer::Clear()
+{
+    CachedWritePos = WritePos.load(std::memory_order_acquire);
+    ReadPos.store(CachedWritePos, std::memory_order_release);
+}
+
+int32 FMultichannelAudioRingBuffer::GetAvailableRead() const
+{
+    // Same load order and clamp as FAudioRingBuffer::GetAvailableRead
+    const uint32 Read = ReadPos.load(std::memory_order_acquire);
+    const uint32 Write = WritePos.load(std::memory_order_acquire);
+    return FMath::Clamp(static_cast<int32>(Write - Read), 0, static_cast<int32>(Capacity));
+}
+
+int32 FMultichannelAudioRingBuffer::GetAvailableWrite() const
+{
+    return static_cast<int32>(Capacity) - GetAvailableRead();
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "JackAudioRingRegion.h"
+#include <atomic>
+
+// Wait-free single-producer/single-consumer audio ring buffer.
+// Exactly one thread may call Write and exactly one (other) thread may call Read/Clear.
+// For input ports the JACK process thread is the producer; for output ports it is the consumer.
+// Capacity is rounded up to a power of two and the indices run freely (wrapping at 2^32), so
+// positions are found with a mask and every transfer is at most two contiguous memcpy segments.
+// Producer and consumer state live on separate cache lines, and each side keeps a cached copy of
+// the other's index that it refreshes only when the cached view cannot satisfy the request, so the
+// producer rarely pulls in the consumer's line and the two sides never write to the same line.
+class FAudioRingBuffer
+{
+public:
+    FAudioRingBuffer(int32 InCapacity = 8192)
+        : Capacity(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 2))))
+        , Mask(Capacity - 1)
+    {
+        Buffer.SetNumZeroed(Capacity);
+    }
+
+    // Producer side. Samples that do not fit are dropped (and counted) instead of moving the reader.
+    // Data may be nullptr to write silence.
+    void Write(const float* Data, int32 NumSamples);
+    // Consumer side. Zero-fills the tail of OutData when fewer than NumSamples are available.
+    int32 Read(float* OutData, int32 NumSamples);
+    // Consumer side. Drops up to NumSamples without copying them; returns how many were dropped.
+    int32 Discard(int32 NumSamples);
+
+    // Zero-copy access. Peek exposes up to MaxSamples of readable (consumer) or writable (producer)
+    // storage in place; Commit then consumes/publishes the first NumSamples of that region.
+    FJackAudioRingRegion PeekRead(int32 MaxSamples);
+    void CommitRead(int32 NumSamples);
+    FJackAudioRingRegion PeekWrite(int32 MaxSamples);
+    void CommitWrite(int32 NumSamples);
+
+    // Consumer side. Discards everything currently readable.
+    void Clear();
+    // Safe from any thread; from a third thread the value is a snapshot within [0, capacity]
+    int32 GetAvailableRead() const;
+    int32 GetAvailableWrite() const;
+    int32 GetCapacity() const { return static_cast<int32>(Capacity); }
+    uint64 GetDroppedSamples() const { return DroppedSamples.load(std::memory_order_relaxed); }
+
+private:
+    uint32 GetFreeForProducer(uint32 Write, int32 Wanted)
+    {
+        if (Capacity - (Write - CachedReadPos) < static_cast<uint32>(Wanted))
+        {
+            CachedReadPos = ReadPos.load(std::memory_order_acquire);
+        }
+        return Capacity - (Write - CachedReadPos);
+    }
+    uint32 GetReadableForConsumer(uint32 Read, int32 Wanted)
+    {
+        if (CachedWritePos - Read < static_cast<uint32>(Wanted))
+        {
+            CachedWritePos = WritePos.load(std::memory_order_acquire);
+        }
+        return CachedWritePos - Read;
+    }
+
+    // Read-only after construction; storage aligned for wide vector loads
+    TArray<float, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Buffer;
+    uint32 Capacity;
+    uint32 Mask;
+
+    // Producer line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WritePos{0};
+    uint32 CachedReadPos = 0;
+    std::atomic<uint64> DroppedSamples{0};
+
+    // Consumer line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadPos{0};
+    uint32 CachedWritePos = 0;
+};
+
+// Wait-free SPSC ring holding every channel of one direction in a single frame-interleaved,
+// cache-line-aligned arena. One read/write cursor pair (in frames) covers all channels, so the
+// channels stay sample-aligned by construction and the producer publishes once per block.
+class FMultichannelAudioRingBuffer
+{
+public:
+    FMultichannelAudioRingBuffer(int32 InNumChannels, int32 InCapacityFrames = 8192);
+
+    // Producer side. ChannelData[c] may be nullptr to write silence for that channel.
+    // Frames that do not fit are dropped (and counted).
+    void WritePlanar(const float* const* ChannelData, int32 NumFrames);
+    void WriteInterleaved(const float* Frames, int32 NumFrames);
+    // Consumer side. OutChannels[c] may be nullptr to skip that channel. Zero-fills missing frames.
+    int32 ReadPlanar(float* const* OutChannels, int32 NumFrames);
+    int32 ReadInterleaved(float* OutFrames, int32 NumFrames);
+    // Consumer side. Discards everything currently readable.
+    void Clear();
+
+    // Zero-copy access in frames; the spans hold interleaved samples (frames * channels floats).
+    FJackAudioRingRegion PeekReadFrames(int32 MaxFrames);
+    void CommitReadFrames(int32 NumFrames);
+    FJackAudioRingRegion PeekWriteFrames(int32 MaxFrames);
+    void CommitWriteFrames(int32 NumFrames);
+
+    // Same thread rules as FAudioRingBuffer::GetAvailableRead
+    int32 GetAvailableRead() const;
+    int32 GetAvailableWrite() const;
+    int32 GetNumChannels() const { return static_cast<int32>(NumChannels); }
+    int32 GetCapacity() const { return static_cast<int32>(Capacity); }
+    uint64 GetDroppedFrames() const { return DroppedFrames.load(std::memory_order_relaxed); }
+
+private:
+    float* FrameAt(uint32 Position) { return Arena.GetData() + (Position & Mask) * NumChannels; }
+    const float* FrameAt(uint32 Position) const { return Arena.GetData() + (Position & Mask) * NumChannels; }
+
+    // Same cached-index scheme as FAudioRingBuffer, in frames
+    uint32 GetFreeForProducer(uint32 Write, int32 Wanted)
+    {
+        if (Capacity - (Write - CachedReadPos) < static_cast<uint32>(Wanted))
+        {
+            CachedReadPos = ReadPos.load(std::memory_order_acquire);
+        }
+        return Capacity - (Write - CachedReadPos);
+    }
+    uint32 GetReadableForConsumer(uint32 Read, int32 Wanted)
+    {
+        if (CachedWritePos - Read < static_cast<uint32>(Wanted))
+        {
+            CachedWritePos = WritePos.load(std::memory_order_acquire);
+        }
+        return CachedWritePos - Read;
+    }
+
+    TArray<float, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Arena;
+    uint32 NumChannels;
+    uint32 Capacity; // In frames, power of two
+    uint32 Mask;
+
+    // Producer line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WritePos{0};
+    uint32 CachedReadPos = 0;
+    std::atomic<uint64> DroppedFrames{0};
+
+    // Consumer line
+    alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadPos{0};
+    uint32 CachedWritePos = 0;
+};
@@ -0,0 +1,127 @@
+#include "JackCallbackTiming.h"
+#include "HAL/PlatformTime.h"
+
+FJackCallbackTimingHistogram::FJackCallbackTimingHistogram()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+int32 FJackCallbackTimingHistogram::GetBucketIndex(uint64 Nanoseconds)
+{
+	if (Nanoseconds < (1ull << MinOctave))
+	{
+		return 0;
+	}
+	const int32 Octave = static_cast<int32>(FPlatformMath::FloorLog2_64(Nanoseconds));
+	const int32 SubBucket = static_cast<int32>((Nanoseconds >> (Octave - SubBucketBits)) & ((1 << SubBucketBits) - 1));
+	return FMath::Min(1 + (Octave - MinOctave) * (1 << SubBucketBits) + SubBucket, NumBuckets - 1);
+}
+
+uint64 FJackCallbackTimingHistogram::GetBucketUpperBound(int32 BucketIndex)
+{
+	if (BucketIndex == 0)
+	{
+		return 1ull << MinOctave;
+	}
+	const int32 Octave = MinOctave + (BucketIndex - 1) / (1 << SubBucketBits);
+	const uint64 SubBucket = (BucketIndex - 1) % (1 << SubBucketBits);
+	return (1ull << Octave) + ((SubBucket + 1) << (Octave - SubBucketBits));
+}
+
+void FJackCallbackTimingHistogram::ResetOnProcessThread()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	NumCycles.store(0, std::memory_order_relaxed);
+	SumNs.store(0, std::memory_order_relaxed);
+	MinNs.store(MAX_uint64, std::memory_order_relaxed);
+	MaxNs.store(0, std::memory_order_relaxed);
+	SumBudgetFraction.store(0.0, std::memory_order_relaxed);
+	MaxBudgetFraction.store(0.0f, std::memory_order_relaxed);
+	NumCyclesOverThreshold.store(0, std::memory_order_relaxed);
+}
+
+void FJackCallbackTimingHistogram::Record(uint64 DurationCycles, uint32 NumFrames, uint32 SampleRate)
+{
+	if (bResetRequested.load(std::memory_order_acquire))
+	{
+		bResetRequested.store(false, std::memory_order_relaxed);
+		ResetOnProcessThread();
+	}
+
+	// Single writer: plain load/store pairs instead of read-modify-write
+	const uint64 Nanoseconds = static_cast<uint64>(DurationCycles * FPlatformTime::GetSecondsPerCycle64() * 1.0e9);
+	LastNs.store(Nanoseconds, std::memory_order_relaxed);
+	std::atomic<uint64>& Bucket = Buckets[GetBucketIndex(Nanoseconds)];
+	Bucket.store(Bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	SumNs.store(SumNs.load(std::memory_order_relaxed) + Nanoseconds, std::memory_order_relaxed);
+	if (Nanoseconds < MinNs.load(std::memory_order_relaxed))
+	{
+		MinNs.store(Nanoseconds, std::memory_order_relaxed);
+	}
+	if (Nanoseconds > MaxNs.load(std::memory_order_relaxed))
+	{
+		MaxNs.store(Nanoseconds, std::memory_order_relaxed);
+	}
+
+	if (NumFrames > 0 && SampleRate > 0)
+	{
+		const float BudgetFraction = static_cast<float>(Nanoseconds * SampleRate / (NumFrames * 1.0e9));
+		LastBudgetFraction.store(BudgetFraction, std::memory_order_relaxed);
+		SumBudgetFraction.store(SumBudgetFraction.load(std::memory_order_relaxed) + BudgetFraction, std::memory_order_relaxed);
+		if (BudgetFraction > MaxBudgetFraction.load(std::memory_order_relaxed))
+		{
+			MaxBudgetFraction.store(BudgetFraction, std::memory_order_relaxed);
+		}
+		if (BudgetFraction > BudgetThreshold.load(std::memory_order_relaxed))
+		{
+			NumCyclesOverThreshold.store(NumCyclesOverThreshold.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+	NumCycles.store(NumCycles.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+FJackCallbackTimingSnapshot FJackCallbackTimingHistogram::GetSnapshot() const
+{
+	FJackCallbackTimingSnapshot Snapshot;
+	Snapshot.BudgetThreshold = BudgetThreshold.load(std::memory_order_relaxed);
+	Snapshot.NumCycles = NumCycles.load(std::memory_order_acquire);
+	if (Snapshot.NumCycles == 0)
+	{
+		return Snapshot;
+	}
+
+	uint64 Counts[NumBuckets];
+	uint64 Total = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Counts[i] = Buckets[i].load(std::memory_order_relaxed);
+		Total += Counts[i];
+	}
+	const uint64 P99Rank = Total - Total / 100;
+	uint64 Seen = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Seen += Counts[i];
+		if (Seen >= P99Rank)
+		{
+			Snapshot.P99Ns = static_cast<double>(GetBucketUpperBound(i));
+			break;
+		}
+	}
+
+	Snapshot.MinNs = static_cast<double>(MinNs.load(std::memory_order_relaxed));
+	Snapshot.MaxNs = static_cast<double>(MaxNs.load(std::memory_order_relaxed));
+	Snapshot.MeanNs = static_cast<double>(SumNs.load(std::memory_order_relaxed)) / Snapshot.NumCycles;
+	// The bucket bound can overshoot the largest sample
+	Snapshot.P99Ns = FMath::Min(Snapshot.P99Ns, Snapshot.MaxNs);
+	Snapshot.MeanBudgetFraction = static_cast<float>(SumBudgetFraction.load(std::memory_order_relaxed) / Snapshot.NumCycles);
+	Snapshot.MaxBudgetFraction = MaxBudgetFraction.load(std::memory_order_relaxed);
+	Snapshot.NumCyclesOverThreshold = NumCyclesOverThreshold.load(std::memory_order_relaxed);
+	return Snapshot;
+}
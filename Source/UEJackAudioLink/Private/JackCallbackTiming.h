@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// Snapshot of FJackCallbackTimingHistogram, computed off the RT thread
+struct FJackCallbackTimingSnapshot
+{
+	uint64 NumCycles = 0;
+	double MinNs = 0.0;
+	double MeanNs = 0.0;
+	double P99Ns = 0.0;
+	double MaxNs = 0.0;
+	float MeanBudgetFraction = 0.0f; // Callback time / cycle period (NumFrames / SampleRate)
+	float MaxBudgetFraction = 0.0f;
+	uint64 NumCyclesOverThreshold = 0;
+	float BudgetThreshold = 0.0f;
+};
+
+// Duration histogram of the process callback with log-spaced buckets (8 per octave, 64 ns to ~2 s,
+// so a percentile is within 12.5% of the true value). Record is called by the process thread only
+// and never blocks; GetSnapshot may run on any thread and sees a consistent-enough view.
+class FJackCallbackTimingHistogram
+{
+public:
+	FJackCallbackTimingHistogram();
+
+	// Process thread only
+	void Record(uint64 DurationCycles, uint32 NumFrames, uint32 SampleRate);
+
+	FJackCallbackTimingSnapshot GetSnapshot() const;
+	// Most recent cycle; not affected by resets
+	uint64 GetLastNs() const { return LastNs.load(std::memory_order_relaxed); }
+	float GetLastBudgetFraction() const { return LastBudgetFraction.load(std::memory_order_relaxed); }
+	// Fraction of the cycle period above which a cycle counts as over budget
+	void SetBudgetThreshold(float Fraction) { BudgetThreshold.store(Fraction, std::memory_order_relaxed); }
+	// Clears the statistics; applied by the process thread at the start of its next cycle
+	void RequestReset() { bResetRequested.store(true, std::memory_order_release); }
+
+private:
+	static constexpr int32 MinOctave = 6;     // 64 ns
+	static constexpr int32 NumOctaves = 25;
+	static constexpr int32 SubBucketBits = 3;
+	static constexpr int32 NumBuckets = 1 + NumOctaves * (1 << SubBucketBits);
+
+	static int32 GetBucketIndex(uint64 Nanoseconds);
+	static uint64 GetBucketUpperBound(int32 BucketIndex);
+	void ResetOnProcessThread();
+
+	std::atomic<uint64> Buckets[NumBuckets];
+	std::atomic<uint64> NumCycles{0};
+	std::atomic<uint64> SumNs{0};
+	std::atomic<uint64> MinNs{MAX_uint64};
+	std::atomic<uint64> MaxNs{0};
+	std::atomic<double> SumBudgetFraction{0.0};
+	std::atomic<float> MaxBudgetFraction{0.0f};
+	std::atomic<uint64> NumCyclesOverThreshold{0};
+	std::atomic<uint64> LastNs{0};
+	std::atomic<float> LastBudgetFraction{0.0f};
+
+	std::atomic<float> BudgetThreshold{0.8f};
+	std::atomic<bool> bResetRequested{false};
+};
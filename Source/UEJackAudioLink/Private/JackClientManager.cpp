@@ -7,94 +7,9 @@
 #if WITH_JACK
 #include <jack/jack.h>
 #include <jack/types.h>
-// Escape regex metacharacters for JACK's POSIX regex patterns in jack_get_ports
-static FString EscapeRegex(const FString& In)
-{
-	// include backslash in the set; double-escape here to keep the literal valid at EOL
-	static const TCHAR* Meta = TEXT(".^$|()[]{}*+?\\");
-	FString Out;
-	Out.Reserve(In.Len() * 2);
-	for (TCHAR C : In)
-	{
-		if (FCString::Strchr(Meta, C) != nullptr)
-		{
-			Out.AppendChar(TEXT('\\'));
-		}
-		Out.AppendChar(C);
-	}
-	return Out;
-}
+#include <cerrno>
 #endif
 
-// FAudioRingBuffer implementation
-void FAudioRingBuffer::Write(const float* Data, int32 NumSamples)
-{
-    FScopeLock Lock(&CriticalSection);
-    for (int32 i = 0; i < NumSamples; ++i)
-    {
-        Buffer[WritePos] = Data[i];
-        WritePos = (WritePos + 1) % Capacity;
-        // If buffer is full, advance read position to avoid overflow
-        if (WritePos == ReadPos)
-        {
-            ReadPos = (ReadPos + 1) % Capacity;
-        }
-    }
-}
-
-int32 FAudioRingBuffer::Read(float* OutData, int32 NumSamples)
-{
-    FScopeLock Lock(&CriticalSection);
-    int32 SamplesRead = 0;
-    while (SamplesRead < NumSamples && ReadPos != WritePos)
-    {
-        OutData[SamplesRead] = Buffer[ReadPos];
-        ReadPos = (ReadPos + 1) % Capacity;
-        SamplesRead++;
-    }
-    // Zero remaining samples if requested more than available
-    for (int32 i = SamplesRead; i < NumSamples; ++i)
-    {
-        OutData[i] = 0.0f;
-    }
-    return SamplesRead;
-}
-
-void FAudioRingBuffer::Clear()
-{
-    FScopeLock Lock(&CriticalSection);
-    ReadPos = WritePos = 0;
-    Buffer.SetNumZeroed(Capacity);
-}
-
-int32 FAudioRingBuffer::GetAvailableRead() const
-{
-    FScopeLock Lock(&CriticalSection);
-    return (WritePos - ReadPos + Capacity) % Capacity;
-}
-
-float FAudioRingBuffer::GetRMSLevel() const
-{
-    FScopeLock Lock(&CriticalSection);
-    if (ReadPos == WritePos) return 0.0f;
-    
-    float Sum = 0.0f;
-    int32 Count = 0;
-    int32 Pos = ReadPos;
-    
-    // Sample recent 1024 samples for RMS calculation
-    int32 SamplesToCheck = FMath::Min(1024, GetAvailableRead());
-    for (int32 i = 0; i < SamplesToCheck; ++i)
-    {
-        float Sample = Buffer[Pos];
-        Sum += Sample * Sample;
-        Pos = (Pos + 1) % Capacity;
-        Count++;
-    }
-    
-    return Count > 0 ? FMath::Sqrt(Sum / Count) : 0.0f;
-}
-
 FJackClientManager& FJackClientManager::Get()
 {
 	static FJackClientManager Singleton;
@@ -137,219 +52,1588 @@ bool FJackClientManager::Connect(const FString& ClientName)
 			// Defer cleanup to game thread to avoid mutating arrays during JACK callback
 			AsyncTask(ENamedThreads::GameThread, [Self]()
 			{
+				Self->GraphEventWorker.Reset();
+				Self->ControlThread.Reset();
 				Self->UnregisterAllPorts();
 				Self->JackClient = nullptr;
+				Self->GraphIndex.Reset();
 			});
 		}
 	}, this);
 	
-	jack_set_xrun_callback(JackClient, [](void* /*arg*/){ UE_LOG(LogJackAudioLink, Verbose, TEXT("JACK xrun")); return 0; }, this);
+	XrunCount.store(0, std::memory_order_relaxed);
+	jack_set_xrun_callback(JackClient, &FJackClientManager::XrunCallback, this);
 	jack_set_client_registration_callback(JackClient, &FJackClientManager::ClientRegistrationCallback, this);
 	jack_set_port_registration_callback(JackClient, &FJackClientManager::PortRegistrationCallback, this);
+	jack_set_port_connect_callback(JackClient, &FJackClientManager::PortConnectCallback, this);
+	jack_set_port_rename_callback(JackClient, &FJackClientManager::PortRenameCallback, this);
+	StartGraphEventWorker();
+	ControlThread = MakeUnique<FJackControlThread>();
+	jack_set_latency_callback(JackClient, &FJackClientManager::LatencyCallback, this);
+	ReportedRingLatency.store(0, std::memory_order_relaxed);
+	if (!LatencyTickHandle.IsValid())
+	{
+		LatencyTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJackClientManager::TickLatency), 0.5f);
+	}
 	
 	// Set the audio process callback
 	jack_set_process_callback(JackClient, &FJackClientManager::ProcessCallback, this);
 	
 	return true;
 #else
-	UE_LOG(LogJackAudioLink, Warning, TEXT("WITH_JACK=0: Connect is a no-op"));
-	return false;
+	UE_LOG(LogJackAudioLink, Warning, TEXT("WITH_JACK=0: Connect is a no-op"));
+	return false;
+#endif
+}
+void FJackClientManager::ClientRegistrationCallback(const char* Name, int Register, void* Arg)
+{
+#if WITH_JACK
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->JackClient || !Name) { return; }
+	const bool bRegistered = (Register != 0);
+	const FString ClientName = UTF8_TO_TCHAR(Name);
+	if (bRegistered)
+	{
+	// Filter out our own client to avoid noise
+	if (ClientName == Self->GetClientName()) { return; }
+	// Do not broadcast here: ports may not be registered yet. PortRegistrationCallback will announce with proper counts.
+	UE_LOG(LogJackAudioLink, Verbose, TEXT("Client registered: %s"), *ClientName);
+	}
+	else
+	{
+		UE_LOG(LogJackAudioLink, Verbose, TEXT("Client unregistered: %s"), *ClientName);
+		if (Self->GraphEventWorker)
+		{
+			FJackGraphEvent Event;
+			Event.Type = FJackGraphEvent::EType::ClientUnregistered;
+			Event.ClientName = ClientName;
+			Self->GraphEventWorker->Enqueue(MoveTemp(Event));
+		}
+	}
+#endif
+}
+
+void FJackClientManager::Disconnect()
+{
+#if WITH_JACK
+	if (LatencyTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LatencyTickHandle);
+		LatencyTickHandle.Reset();
+	}
+	if (JackClient)
+	{
+		// Deactivate first to halt callbacks, then unregister ports, then close client
+		jack_deactivate(JackClient);
+		// The workers may be (dis)connecting; they go before the client does. Queued routing still runs
+		// (and fails, the client being inactive) so no future is left unfulfilled.
+		GraphEventWorker.Reset();
+		ControlThread.Reset();
+		UnregisterAllPorts();
+		jack_client_close(JackClient);
+		JackClient = nullptr;
+	}
+	GraphIndex.Reset();
+#endif
+}
+
+bool FJackClientManager::IsConnected() const
+{
+	return JackClient != nullptr;
+}
+
+bool FJackClientManager::RegisterAudioPorts(int32 NumInputs, int32 NumOutputs, const FString& BaseName, bool bUseMultichannelRing)
+{
+#if WITH_JACK
+	if (!JackClient)
+	{
+		return false;
+	}
+	NumInputs = FMath::Max(NumInputs, 0);
+	NumOutputs = FMath::Max(NumOutputs, 0);
+
+	// Ports keep their names as long as the base name does not change, so the leading ones carry over
+	// (and with them their connections, rings and meters); rings carry over unless the ring mode changes.
+	const FJackPortSetPtr Current = GetPortSet();
+	const bool bKeepPorts = Current.IsValid() && Current->BaseName == BaseName;
+	const bool bKeepRings = bKeepPorts && Current->bUseMultichannelRing == bUseMultichannelRing;
+	const int32 KeptInputs = bKeepPorts ? FMath::Min(NumInputs, Current->InputPorts.Num()) : 0;
+	const int32 KeptOutputs = bKeepPorts ? FMath::Min(NumOutputs, Current->OutputPorts.Num()) : 0;
+
+	TSharedRef<FJackPortSet> NewPortSet = MakeShared<FJackPortSet>();
+	NewPortSet->BaseName = BaseName;
+	NewPortSet->bUseMultichannelRing = bUseMultichannelRing;
+
+	for (int32 i = 0; i < NumInputs; ++i)
+	{
+		if (i < KeptInputs)
+		{
+			NewPortSet->InputPorts.Add(Current->InputPorts[i]);
+			NewPortSet->InputMeters.Add(Current->InputMeters[i]);
+			NewPortSet->InputConnections.Add(Current->InputConnections[i]);
+			if (!bUseMultichannelRing)
+			{
+				NewPortSet->InputRingBuffers.Add(bKeepRings ? Current->InputRingBuffers[i] : MakeShared<FAudioRingBuffer>(8192));
+			}
+			continue;
+		}
+		FString Name = FString::Printf(TEXT("%s_in_%d"), *BaseName, i + 1);
+		FTCHARToUTF8 NameUtf8(*Name);
+		jack_port_t* Port = jack_port_register(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+		if (Port) 
+		{ 
+			NewPortSet->InputPorts.Add(Port);
+			NewPortSet->InputMeters.Add(MakeShared<FJackChannelMeter>());
+			NewPortSet->InputConnections.Add(MakeShared<FJackPortConnection>());
+			if (!bUseMultichannelRing)
+			{
+				NewPortSet->InputRingBuffers.Add(MakeShared<FAudioRingBuffer>(8192));
+			}
+		}
+	}
+	
+	for (int32 i = 0; i < NumOutputs; ++i)
+	{
+		if (i < KeptOutputs)
+		{
+			NewPortSet->OutputPorts.Add(Current->OutputPorts[i]);
+			NewPortSet->OutputConnections.Add(Current->OutputConnections[i]);
+			if (!bUseMultichannelRing)
+			{
+				NewPortSet->OutputRingBuffers.Add(bKeepRings ? Current->OutputRingBuffers[i] : MakeShared<FAudioRingBuffer>(8192));
+			}
+			continue;
+		}
+		FString Name = FString::Printf(TEXT("%s_out_%d"), *BaseName, i + 1);
+		FTCHARToUTF8 NameUtf8(*Name);
+		jack_port_t* Port = jack_port_register(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+		if (Port) 
+		{ 
+			NewPortSet->OutputPorts.Add(Port);
+			NewPortSet->OutputConnections.Add(MakeShared<FJackPortConnection>());
+			if (!bUseMultichannelRing)
+			{
+				NewPortSet->OutputRingBuffers.Add(MakeShared<FAudioRingBuffer>(8192));
+			}
+		}
+	}
+
+	if (bUseMultichannelRing)
+	{
+		const int32 NumInputPorts = NewPortSet->InputPorts.Num();
+		const int32 NumOutputPorts = NewPortSet->OutputPorts.Num();
+		if (NumInputPorts > 0)
+		{
+			const bool bKeepBlockRing = bKeepRings && Current->InputBlockRing.IsValid() && Current->InputBlockRing->GetNumChannels() == NumInputPorts;
+			NewPortSet->InputBlockRing = bKeepBlockRing ? Current->InputBlockRing : MakeShared<FMultichannelAudioRingBuffer>(NumInputPorts, 8192);
+			NewPortSet->InputPortBuffers.SetNumZeroed(NumInputPorts);
+		}
+		if (NumOutputPorts > 0)
+		{
+			const bool bKeepBlockRing = bKeepRings && Current->OutputBlockRing.IsValid() && Current->OutputBlockRing->GetNumChannels() == NumOutputPorts;
+			NewPortSet->OutputBlockRing = bKeepBlockRing ? Current->OutputBlockRing : MakeShared<FMultichannelAudioRingBuffer>(NumOutputPorts, 8192);
+		}
+	}
+	NewPortSet->OutputPortBuffers.SetNumZeroed(NewPortSet->OutputPorts.Num());
+	SetUpRateConversion(*NewPortSet, jack_get_sample_rate(JackClient), InputRingSampleRate, OutputRingSampleRate);
+
+	// Ports that did not carry over are unregistered once the process callback has moved to the new set
+	TArray<jack_port_t*> PortsToUnregister;
+	if (Current.IsValid())
+	{
+		for (int32 i = KeptInputs; i < Current->InputPorts.Num(); ++i)
+		{
+			PortsToUnregister.Add(Current->InputPorts[i]);
+		}
+		for (int32 i = KeptOutputs; i < Current->OutputPorts.Num(); ++i)
+		{
+			PortsToUnregister.Add(Current->OutputPorts[i]);
+		}
+	}
+	PublishPortSet(NewPortSet, MoveTemp(PortsToUnregister));
+	// Connections made while the set was being built were reported against the old set
+	UpdatePortConnections(*NewPortSet);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FJackClientManager::UnregisterAllPorts()
+{
+#if WITH_JACK
+	const FJackPortSetPtr Current = GetPortSet();
+	if (!Current.IsValid())
+	{
+		return;
+	}
+	TArray<jack_port_t*> PortsToUnregister = Current->InputPorts;
+	PortsToUnregister.Append(Current->OutputPorts);
+	PublishPortSet(nullptr, MoveTemp(PortsToUnregister));
+#endif
+}
+
+#if WITH_JACK
+FJackPortSetPtr FJackClientManager::GetPortSet() const
+{
+	FScopeLock Lock(&PortSetLock);
+	return ActivePortSet;
+}
+
+void FJackClientManager::PublishPortSet(FJackPortSetPtr NewPortSet, TArray<jack_port_t*> PortsToUnregister)
+{
+	FJackPortSetPtr OldPortSet;
+	{
+		FScopeLock Lock(&PortSetLock);
+		OldPortSet = MoveTemp(ActivePortSet);
+		ActivePortSet = NewPortSet;
+		PortSetGeneration.fetch_add(1, std::memory_order_release);
+	}
+	RTPortSet.store(NewPortSet.Get(), std::memory_order_seq_cst);
+	if (OldPortSet.IsValid())
+	{
+		RetiredPortSets.Add({ MoveTemp(OldPortSet), MoveTemp(PortsToUnregister) });
+	}
+
+	// Usually the callback is not inside the old set right now and it goes away immediately;
+	// otherwise retry on the game thread until the pin is released.
+	if (ReclaimRetiredPortSets() && !RetireTickHandle.IsValid())
+	{
+		RetireTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float /*DeltaTime*/)
+		{
+			const bool bPending = ReclaimRetiredPortSets();
+			if (!bPending)
+			{
+				RetireTickHandle.Reset();
+			}
+			return bPending;
+		}));
+	}
+}
+
+bool FJackClientManager::ReclaimRetiredPortSets()
+{
+	// Pairs with the pin/re-check in ProcessCallback: once RTPortSet no longer points at a set, the callback
+	// can only be inside it if its pin is visible here.
+	const FJackPortSet* InUse = RTPortSetInUse.load(std::memory_order_seq_cst);
+	for (int32 i = RetiredPortSets.Num() - 1; i >= 0; --i)
+	{
+		if (RetiredPortSets[i].PortSet.Get() == InUse)
+		{
+			continue;
+		}
+		for (jack_port_t* Port : RetiredPortSets[i].PortsToUnregister)
+		{
+			if (Port && JackClient) { jack_port_unregister(JackClient, Port); }
+		}
+		RetiredPortSets.RemoveAt(i);
+	}
+	return RetiredPortSets.Num() > 0;
+}
+
+void FJackClientManager::UpdatePortConnections(const FJackPortSet& PortSet, const jack_port_t* PortA, const jack_port_t* PortB) const
+{
+	const bool bAll = !PortA && !PortB;
+	for (int32 i = 0; i < PortSet.InputPorts.Num(); ++i)
+	{
+		jack_port_t* Port = PortSet.InputPorts[i];
+		if (bAll || Port == PortA || Port == PortB)
+		{
+			PortSet.InputConnections[i]->bConnected.store(jack_port_connected(Port) > 0, std::memory_order_relaxed);
+		}
+	}
+	for (int32 i = 0; i < PortSet.OutputPorts.Num(); ++i)
+	{
+		jack_port_t* Port = PortSet.OutputPorts[i];
+		if (bAll || Port == PortA || Port == PortB)
+		{
+			PortSet.OutputConnections[i]->bConnected.store(jack_port_connected(Port) > 0, std::memory_order_relaxed);
+		}
+	}
+}
+#endif
+
+void FJackClientManager::PortConnectCallback(jack_port_id_t PortA, jack_port_id_t PortB, int Connect, void* Arg)
+{
+#if WITH_JACK
+	// Runs on JACK's notification thread, not the process thread
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->JackClient)
+	{
+		return;
+	}
+	jack_port_t* A = jack_port_by_id(Self->JackClient, PortA);
+	jack_port_t* B = jack_port_by_id(Self->JackClient, PortB);
+	if (A && B && Self->GraphEventWorker)
+	{
+		FJackGraphEvent Event;
+		Event.Type = Connect != 0 ? FJackGraphEvent::EType::PortsConnected : FJackGraphEvent::EType::PortsDisconnected;
+		Event.Name = UTF8_TO_TCHAR(jack_port_name(A));
+		Event.OtherName = UTF8_TO_TCHAR(jack_port_name(B));
+		Self->GraphEventWorker->Enqueue(MoveTemp(Event));
+	}
+	if (const FJackPortSetPtr PortSet = Self->GetPortSet())
+	{
+		Self->UpdatePortConnections(*PortSet, A, B);
+	}
+#endif
+}
+
+#if WITH_JACK
+void FJackClientManager::PortRenameCallback(jack_port_id_t /*Port*/, const char* OldName, const char* NewName, void* Arg)
+{
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->GraphEventWorker || !OldName || !NewName)
+	{
+		return;
+	}
+	FJackGraphEvent Event;
+	Event.Type = FJackGraphEvent::EType::PortRenamed;
+	Event.Name = UTF8_TO_TCHAR(OldName);
+	Event.OtherName = UTF8_TO_TCHAR(NewName);
+	Self->GraphEventWorker->Enqueue(MoveTemp(Event));
+}
+
+void FJackClientManager::StartGraphEventWorker()
+{
+	// Announcements come out of the worker once per client, after its ports have settled
+	GraphEventWorker = MakeUnique<FJackGraphEventWorker>(GraphIndex,
+		[this](const FString& ClientName, int32 NumIn, int32 NumOut)
+		{
+			UE_LOG(LogJackAudioLink, Log, TEXT("Client connected: %s (in:%d, out:%d)"), *ClientName, NumIn, NumOut);
+			AsyncTask(ENamedThreads::GameThread, [ClientName, NumIn, NumOut]()
+			{
+				if (GEngine)
+				{
+					if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+					{
+						Subsys->NotifyClientConnected(ClientName, NumIn, NumOut);
+					}
+				}
+			});
+			// Optional auto-connect; jack_connect is fine here, unlike on the notification thread
+			AutoConnectToClient(ClientName);
+		},
+		[](const FString& ClientName)
+		{
+			UE_LOG(LogJackAudioLink, Log, TEXT("Client disconnected: %s"), *ClientName);
+			AsyncTask(ENamedThreads::GameThread, [ClientName]()
+			{
+				if (GEngine)
+				{
+					if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+					{
+						Subsys->NotifyClientDisconnected(ClientName);
+					}
+				}
+			});
+		});
+}
+
+void FJackClientManager::RebuildGraphIndex()
+{
+	if (!JackClient)
+	{
+		return;
+	}
+	GraphIndex.Rebuild([this](TArray<FJackGraphPortInfo>& OutPorts)
+	{
+		const char** Names = jack_get_ports(JackClient, nullptr, nullptr, 0);
+		if (!Names)
+		{
+			return;
+		}
+		for (int i = 0; Names[i] != nullptr; ++i)
+		{
+			jack_port_t* Port = jack_port_by_name(JackClient, Names[i]);
+			if (!Port)
+			{
+				continue;
+			}
+			FJackGraphPortInfo& Info = OutPorts.AddDefaulted_GetRef();
+			Info.Name = UTF8_TO_TCHAR(Names[i]);
+			Info.bInput = (jack_port_flags(Port) & JackPortIsInput) != 0;
+			Info.bAudio = FCStringAnsi::Strcmp(jack_port_type(Port), JACK_DEFAULT_AUDIO_TYPE) == 0;
+			// Only one end of each connection needs listing
+			if (!Info.bInput)
+			{
+				if (const char** Connections = jack_port_get_all_connections(JackClient, Port))
+				{
+					for (int c = 0; Connections[c] != nullptr; ++c)
+					{
+						Info.Connections.Add(UTF8_TO_TCHAR(Connections[c]));
+					}
+					jack_free(const_cast<char**>(Connections));
+				}
+			}
+		}
+		jack_free(const_cast<char**>(Names));
+	});
+	UE_LOG(LogJackAudioLink, Verbose, TEXT("Graph index built: %d clients"), GraphIndex.GetClients().Num());
+}
+#endif
+
+#if WITH_JACK
+int32 FJackClientManager::ProcessPortSet(const FJackPortSet& Set, jack_nframes_t NumFrames, const FJackMeterCoefficients& MeterCoefficients, FJackGetPortBufferFunc GetPortBuffer)
+{
+	// Unconnected ports (usually most of them) are skipped: inputs are neither fetched nor metered but
+	// their rings still get silence, so every channel stays readable and in phase with the others;
+	// outputs just get silence while their audio is dropped so the rings keep draining
+	int32 NumActivePorts = 0;
+
+	// Directions with rate conversion go through the converter in both ring modes.
+	// Multichannel ring mode: gather the port buffers and move the whole block with one cursor update.
+	// A null channel pointer writes silence / drops the channel, so the shared cursor still advances.
+	if (Set.InputConverter.IsValid())
+	{
+		NumActivePorts += ProcessConvertedInputs(Set, NumFrames, MeterCoefficients, GetPortBuffer);
+	}
+	else if (Set.InputBlockRing.IsValid())
+	{
+		for (int32 i = 0; i < Set.InputPorts.Num(); ++i)
+		{
+			if (!Set.InputConnections[i]->bConnected.load(std::memory_order_relaxed))
+			{
+				Set.InputPortBuffers[i] = nullptr;
+				Set.InputMeters[i]->Clear();
+				continue;
+			}
+			++NumActivePorts;
+			Set.InputPortBuffers[i] = static_cast<float*>(GetPortBuffer(Set.InputPorts[i], NumFrames));
+			Set.InputMeters[i]->Update(Set.InputPortBuffers[i], NumFrames, MeterCoefficients);
+		}
+		Set.InputBlockRing->WritePlanar(Set.InputPortBuffers.GetData(), NumFrames);
+	}
+	else
+	{
+		// Process input ports
+		for (int32 i = 0; i < Set.InputRingBuffers.Num(); ++i)
+		{
+			if (!Set.InputConnections[i]->bConnected.load(std::memory_order_relaxed))
+			{
+				Set.InputRingBuffers[i]->Write(nullptr, NumFrames);
+				Set.InputMeters[i]->Clear();
+				continue;
+			}
+			++NumActivePorts;
+			jack_default_audio_sample_t* InBuffer = static_cast<jack_default_audio_sample_t*>(
+				GetPortBuffer(Set.InputPorts[i], NumFrames));
+			// A null buffer writes silence
+			Set.InputRingBuffers[i]->Write(InBuffer, NumFrames);
+			if (InBuffer)
+			{
+				Set.InputMeters[i]->Update(InBuffer, NumFrames, MeterCoefficients);
+			}
+		}
+	}
+
+	if (Set.OutputConverter.IsValid())
+	{
+		NumActivePorts += ProcessConvertedOutputs(Set, NumFrames, GetPortBuffer);
+	}
+	else if (Set.OutputBlockRing.IsValid())
+	{
+		for (int32 i = 0; i < Set.OutputPorts.Num(); ++i)
+		{
+			float* OutBuffer = static_cast<float*>(GetPortBuffer(Set.OutputPorts[i], NumFrames));
+			// A null channel pointer (no buffer, or unconnected) drops that channel's frames
+			if (OutBuffer && !Set.OutputConnections[i]->bConnected.load(std::memory_order_relaxed))
+			{
+				FMemory::Memzero(OutBuffer, NumFrames * sizeof(float));
+				OutBuffer = nullptr;
+			}
+			else if (OutBuffer)
+			{
+				++NumActivePorts;
+			}
+			Set.OutputPortBuffers[i] = OutBuffer;
+		}
+		Set.OutputBlockRing->ReadPlanar(Set.OutputPortBuffers.GetData(), NumFrames);
+	}
+	else
+	{
+		// Process output ports
+		for (int32 i = 0; i < Set.OutputRingBuffers.Num(); ++i)
+		{
+			jack_default_audio_sample_t* OutBuffer = static_cast<jack_default_audio_sample_t*>(
+				GetPortBuffer(Set.OutputPorts[i], NumFrames));
+			if (!OutBuffer)
+			{
+				continue;
+			}
+			if (!Set.OutputConnections[i]->bConnected.load(std::memory_order_relaxed))
+			{
+				FMemory::Memzero(OutBuffer, NumFrames * sizeof(float));
+				Set.OutputRingBuffers[i]->Discard(NumFrames);
+				continue;
+			}
+			++NumActivePorts;
+			// Read from ring buffer to output
+			Set.OutputRingBuffers[i]->Read(OutBuffer, NumFrames);
+		}
+	}
+
+	return NumActivePorts;
+}
+
+int32 FJackClientManager::ProcessConvertedInputs(const FJackPortSet& Set, jack_nframes_t NumFrames, const FJackMeterCoefficients& MeterCoefficients, FJackGetPortBufferFunc GetPortBuffer)
+{
+	// Each connected port is converted into its row of the scratch, then written at the game rate.
+	// Blocks longer than the converter was sized for lose their tail.
+	FJackSampleRateConverter& Converter = *Set.InputConverter;
+	const int32 NumInput = FMath::Min(static_cast<int32>(NumFrames), Converter.GetMaxInputFrames());
+	const int32 NumOutput = Converter.Plan(NumInput, Set.InputConvertStride);
+	int32 NumActivePorts = 0;
+	for (int32 i = 0; i < Set.InputPorts.Num(); ++i)
+	{
+		Set.ConvertChannels[i] = nullptr;
+		const bool bConnected = Set.InputConnections[i]->bConnected.load(std::memory_order_relaxed);
+		const float* InBuffer = bConnected ? static_cast<const float*>(GetPortBuffer(Set.InputPorts[i], NumFrames)) : nullptr;
+		if (!InBuffer)
+		{
+			// Silence at the game rate keeps the channel aligned; the block ring gets it from the null pointer
+			if (!bConnected)
+			{
+				Set.InputMeters[i]->Clear();
+				Converter.ClearChannel(i);
+			}
+			if (!Set.InputBlockRing.IsValid())
+			{
+				Set.InputRingBuffers[i]->Write(nullptr, NumOutput);
+			}
+			continue;
+		}
+		++NumActivePorts;
+		Set.InputMeters[i]->Update(InBuffer, NumFrames, MeterCoefficients);
+		float* Converted = Set.InputConvertBuffer.GetData() + i * Set.InputConvertStride;
+		Converter.ProcessChannel(i, InBuffer, Converted);
+		if (Set.InputBlockRing.IsValid())
+		{
+			Set.ConvertChannels[i] = Converted;
+		}
+		else
+		{
+			Set.InputRingBuffers[i]->Write(Converted, NumOutput);
+		}
+	}
+	Converter.Commit();
+	if (Set.InputBlockRing.IsValid())
+	{
+		Set.InputBlockRing->WritePlanar(Set.ConvertChannels.GetData(), NumOutput);
+	}
+	return NumActivePorts;
+}
+
+int32 FJackClientManager::ProcessConvertedOutputs(const FJackPortSet& Set, jack_nframes_t NumFrames, FJackGetPortBufferFunc GetPortBuffer)
+{
+	// Take exactly the game-rate frames that convert to this period from each ring, then convert into the port
+	FJackSampleRateConverter& Converter = *Set.OutputConverter;
+	const int32 NumInput = FMath::Min(Converter.GetInputFramesNeeded(NumFrames), Converter.GetMaxInputFrames());
+	const int32 NumOutput = Converter.Plan(NumInput, NumFrames);
+	int32 NumActivePorts = 0;
+	for (int32 i = 0; i < Set.OutputPorts.Num(); ++i)
+	{
+		Set.OutputPortBuffers[i] = static_cast<float*>(GetPortBuffer(Set.OutputPorts[i], NumFrames));
+		Set.ConvertChannels[i] = nullptr;
+		if (!Set.OutputPortBuffers[i])
+		{
+			continue;
+		}
+		if (!Set.OutputConnections[i]->bConnected.load(std::memory_order_relaxed))
+		{
+			FMemory::Memzero(Set.OutputPortBuffers[i], NumFrames * sizeof(float));
+			Set.OutputPortBuffers[i] = nullptr;
+			Converter.ClearChannel(i);
+			continue;
+		}
+		++NumActivePorts;
+		Set.ConvertChannels[i] = Set.OutputConvertBuffer.GetData() + i * Set.OutputConvertStride;
+	}
+
+	// Unconnected outputs are drained like in the unconverted path, so the rings keep moving
+	if (Set.OutputBlockRing.IsValid())
+	{
+		Set.OutputBlockRing->ReadPlanar(Set.ConvertChannels.GetData(), NumInput);
+	}
+	for (int32 i = 0; i < Set.OutputPorts.Num(); ++i)
+	{
+		if (!Set.ConvertChannels[i])
+		{
+			if (!Set.OutputBlockRing.IsValid())
+			{
+				Set.OutputRingBuffers[i]->Discard(NumInput);
+			}
+			continue;
+		}
+		if (!Set.OutputBlockRing.IsValid())
+		{
+			Set.OutputRingBuffers[i]->Read(Set.ConvertChannels[i], NumInput);
+		}
+		Converter.ProcessChannel(i, Set.ConvertChannels[i], Set.OutputPortBuffers[i]);
+		if (NumOutput < static_cast<int32>(NumFrames))
+		{
+			FMemory::Memzero(Set.OutputPortBuffers[i] + NumOutput, (NumFrames - NumOutput) * sizeof(float));
+		}
+	}
+	Converter.Commit();
+	return NumActivePorts;
+}
+
+void FJackClientManager::SetUpRateConversion(FJackPortSet& Set, uint32 JackSampleRate, uint32 InputGameSampleRate, uint32 OutputGameSampleRate)
+{
+	// Converters are sized for the largest JACK period the settings offer
+	constexpr int32 MaxPeriodFrames = 4096;
+	const int32 NumInputs = Set.InputPorts.Num();
+	const int32 NumOutputs = Set.OutputPorts.Num();
+	if (JackSampleRate == 0)
+	{
+		return;
+	}
+	if (InputGameSampleRate != 0 && InputGameSampleRate != JackSampleRate && NumInputs > 0)
+	{
+		TSharedPtr<FJackSampleRateConverter> Converter = MakeShared<FJackSampleRateConverter>();
+		if (Converter->Init(JackSampleRate, InputGameSampleRate, NumInputs, MaxPeriodFrames))
+		{
+			Set.InputConverter = Converter;
+			Set.InputConvertStride = Align(Converter->GetMaxOutputFrames(MaxPeriodFrames), 4);
+			Set.InputConvertBuffer.SetNumZeroed(NumInputs * Set.InputConvertStride);
+		}
+		else
+		{
+			UE_LOG(LogJackAudioLink, Warning, TEXT("Cannot convert inputs from %u Hz to %u Hz; they stay at the JACK rate"), JackSampleRate, InputGameSampleRate);
+		}
+	}
+	if (OutputGameSampleRate != 0 && OutputGameSampleRate != JackSampleRate && NumOutputs > 0)
+	{
+		const int32 MaxInputFrames = static_cast<int32>((static_cast<int64>(MaxPeriodFrames) * OutputGameSampleRate + JackSampleRate - 1) / JackSampleRate) + 2;
+		TSharedPtr<FJackSampleRateConverter> Converter = MakeShared<FJackSampleRateConverter>();
+		if (Converter->Init(OutputGameSampleRate, JackSampleRate, NumOutputs, MaxInputFrames))
+		{
+			Set.OutputConverter = Converter;
+			Set.OutputConvertStride = Align(MaxInputFrames, 4);
+			Set.OutputConvertBuffer.SetNumZeroed(NumOutputs * Set.OutputConvertStride);
+		}
+		else
+		{
+			UE_LOG(LogJackAudioLink, Warning, TEXT("Cannot convert outputs from %u Hz to %u Hz; they stay at the JACK rate"), OutputGameSampleRate, JackSampleRate);
+		}
+	}
+	if (Set.InputConverter.IsValid() || Set.OutputConverter.IsValid())
+	{
+		Set.ConvertChannels.SetNumZeroed(FMath::Max(NumInputs, NumOutputs));
+		// The converted output path gathers its port pointers here in both ring modes
+		Set.OutputPortBuffers.SetNumZeroed(NumOutputs);
+	}
+}
+
+#endif
+
+// JACK Process Callback - This runs in real-time thread
+#if WITH_JACK
+int32 FJackClientManager::GetRingFill(const FJackPortSet& PortSet, bool bInput, int32 ChannelIndex)
+{
+	if (PortSet.bUseMultichannelRing)
+	{
+		const TSharedPtr<FMultichannelAudioRingBuffer>& Ring = bInput ? PortSet.InputBlockRing : PortSet.OutputBlockRing;
+		return Ring.IsValid() ? Ring->GetAvailableRead() : 0;
+	}
+	const TArray<TSharedPtr<FAudioRingBuffer>>& Rings = bInput ? PortSet.InputRingBuffers : PortSet.OutputRingBuffers;
+	return Rings.IsValidIndex(ChannelIndex) ? Rings[ChannelIndex]->GetAvailableRead() : 0;
+}
+
+int32 FJackClientManager::GetRingLatency(const FJackPortSet& PortSet, bool bInput, int32 ChannelIndex)
+{
+	const int32 Fill = GetRingFill(PortSet, bInput, ChannelIndex);
+	const FJackSampleRateConverter* Converter = bInput ? PortSet.InputConverter.Get() : PortSet.OutputConverter.Get();
+	if (!Converter)
+	{
+		return Fill;
+	}
+	// Converted rings count game-rate frames; the filter adds half its length on its input side
+	if (bInput)
+	{
+		return static_cast<int32>(static_cast<int64>(Fill) * Converter->GetInputRate() / Converter->GetOutputRate()) + Converter->GetLatencyInputFrames();
+	}
+	return static_cast<int32>((static_cast<int64>(Fill) + Converter->GetLatencyInputFrames()) * Converter->GetOutputRate() / Converter->GetInputRate());
+}
+
+int32 FJackClientManager::GetMaxRingLatency(const FJackPortSet& PortSet, bool bInput)
+{
+	const int32 NumPorts = bInput ? PortSet.InputPorts.Num() : PortSet.OutputPorts.Num();
+	int32 MaxLatency = 0;
+	for (int32 i = 0; i < NumPorts; ++i)
+	{
+		MaxLatency = FMath::Max(MaxLatency, GetRingLatency(PortSet, bInput, i));
+	}
+	return MaxLatency;
+}
+
+void FJackClientManager::LatencyCallback(jack_latency_callback_mode_t Mode, void* Arg)
+{
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->JackClient)
+	{
+		return;
+	}
+	const FJackPortSetPtr PortSet = Self->GetPortSet();
+	if (!PortSet)
+	{
+		return;
+	}
+
+	// To JACK we look like a processor whose inputs reach its outputs through the game: pass the
+	// upstream (capture) or downstream (playback) range through and add the buffering of both rings.
+	const int32 InputRingFill = GetMaxRingLatency(*PortSet, true);
+	const int32 OutputRingFill = GetMaxRingLatency(*PortSet, false);
+	Self->ReportedRingLatency.store(InputRingFill + OutputRingFill, std::memory_order_relaxed);
+
+	const bool bCapture = (Mode == JackCaptureLatency);
+	const TArray<jack_port_t*>& FromPorts = bCapture ? PortSet->InputPorts : PortSet->OutputPorts;
+	const TArray<jack_port_t*>& ToPorts = bCapture ? PortSet->OutputPorts : PortSet->InputPorts;
+
+	jack_latency_range_t Through = { 0, 0 };
+	bool bFirst = true;
+	for (jack_port_t* Port : FromPorts)
+	{
+		jack_latency_range_t Range;
+		jack_port_get_latency_range(Port, Mode, &Range);
+		Through.min = bFirst ? Range.min : FMath::Min(Through.min, Range.min);
+		Through.max = bFirst ? Range.max : FMath::Max(Through.max, Range.max);
+		bFirst = false;
+	}
+	for (int32 i = 0; i < ToPorts.Num(); ++i)
+	{
+		const int32 RingFrames = bCapture ? InputRingFill + GetRingLatency(*PortSet, false, i) : GetRingLatency(*PortSet, true, i) + OutputRingFill;
+		jack_latency_range_t Range = { Through.min + RingFrames, Through.max + RingFrames };
+		jack_port_set_latency_range(ToPorts[i], Mode, &Range);
+	}
+}
+
+bool FJackClientManager::TickLatency(float /*DeltaTime*/)
+{
+	if (!JackClient)
+	{
+		return true;
+	}
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (!PortSet)
+	{
+		return true;
+	}
+	const int32 RingLatency = GetMaxRingLatency(*PortSet, true) + GetMaxRingLatency(*PortSet, false);
+	const int32 Drift = FMath::Abs(RingLatency - ReportedRingLatency.load(std::memory_order_relaxed));
+	if (Drift >= FMath::Max<int32>(jack_get_buffer_size(JackClient), 1))
+	{
+		// Re-runs LatencyCallback for the whole graph so downstream clients see our new figures
+		jack_recompute_total_latencies(JackClient);
+	}
+	return true;
+}
+#endif
+
+bool FJackClientManager::GetPortLatency(bool bInput, int32 ChannelIndex, FJackPortLatency& OutLatency) const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (!JackClient || !PortSet)
+	{
+		return false;
+	}
+	const TArray<jack_port_t*>& Ports = bInput ? PortSet->InputPorts : PortSet->OutputPorts;
+	if (!Ports.IsValidIndex(ChannelIndex))
+	{
+		return false;
+	}
+	jack_latency_range_t Range;
+	jack_port_get_latency_range(Ports[ChannelIndex], bInput ? JackCaptureLatency : JackPlaybackLatency, &Range);
+	OutLatency.JackMinFrames = static_cast<int32>(Range.min);
+	OutLatency.JackMaxFrames = static_cast<int32>(Range.max);
+	OutLatency.RingFrames = GetRingLatency(*PortSet, bInput, ChannelIndex);
+	return true;
+#else
+	return false;
+#endif
+}
+
+int FJackClientManager::XrunCallback(void* Arg)
+{
+#if WITH_JACK
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->JackClient)
+	{
+		return 0;
+	}
+
+	FJackXrunEvent Event;
+	Event.SequenceNumber = Self->XrunCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	Event.PlatformSeconds = FPlatformTime::Seconds();
+	Event.DelayedMicroseconds = jack_get_xrun_delayed_usecs(Self->JackClient);
+	Event.FrameTime = jack_frame_time(Self->JackClient);
+	Event.LastCallbackNs = Self->CallbackTiming.GetLastNs();
+	Event.LastCallbackBudgetFraction = Self->CallbackTiming.GetLastBudgetFraction();
+	Event.InputRingFill = Self->LastCycleInputRingFill.load(std::memory_order_relaxed);
+	Event.OutputRingFill = Self->LastCycleOutputRingFill.load(std::memory_order_relaxed);
+	// A full queue means the game thread is stalled; the count above still includes this xrun
+	Self->XrunEvents.Enqueue(Event);
+	UE_LOG(LogJackAudioLink, Verbose, TEXT("JACK xrun #%llu (delayed %.0f us)"), Event.SequenceNumber, Event.DelayedMicroseconds);
+#endif
+	return 0;
+}
+
+int FJackClientManager::ProcessCallback(jack_nframes_t NumFrames, void* Arg)
+{
+#if WITH_JACK
+	const uint64 EntryCycles = FPlatformTime::Cycles64();
+	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
+	if (!Self || !Self->JackClient)
+	{
+		return 0;
+	}
+
+	// Pin the active port set, then confirm it is still active: either the game thread sees the pin
+	// before it frees the set, or we see its swap here and pin the new one instead.
+	const FJackPortSet* PortSet = Self->RTPortSet.load(std::memory_order_seq_cst);
+	for (;;)
+	{
+		Self->RTPortSetInUse.store(PortSet, std::memory_order_seq_cst);
+		const FJackPortSet* Current = Self->RTPortSet.load(std::memory_order_seq_cst);
+		if (Current == PortSet)
+		{
+			break;
+		}
+		PortSet = Current;
+	}
+
+	const jack_nframes_t SampleRate = jack_get_sample_rate(Self->JackClient);
+	int32 NumActivePorts = 0;
+	int32 NumRegisteredPorts = 0;
+	if (PortSet)
+	{
+		const FJackMeterCoefficients MeterCoefficients = FJackMeterCoefficients::Make(NumFrames, SampleRate,
+			Self->MeterIntegrationWindowSeconds.load(std::memory_order_relaxed), Self->MeterPeakDecayDbPerSecond.load(std::memory_order_relaxed));
+		NumActivePorts = ProcessPortSet(*PortSet, NumFrames, MeterCoefficients, &jack_port_get_buffer);
+		NumRegisteredPorts = PortSet->InputPorts.Num() + PortSet->OutputPorts.Num();
+		if (PortSet->bUseMultichannelRing)
+		{
+			Self->LastCycleInputRingFill.store(PortSet->InputBlockRing.IsValid() ? PortSet->InputBlockRing->GetAvailableRead() : 0, std::memory_order_relaxed);
+			Self->LastCycleOutputRingFill.store(PortSet->OutputBlockRing.IsValid() ? PortSet->OutputBlockRing->GetAvailableRead() : 0, std::memory_order_relaxed);
+		}
+		else
+		{
+			Self->LastCycleInputRingFill.store(PortSet->InputRingBuffers.Num() > 0 ? PortSet->InputRingBuffers[0]->GetAvailableRead() : 0, std::memory_order_relaxed);
+			Self->LastCycleOutputRingFill.store(PortSet->OutputRingBuffers.Num() > 0 ? PortSet->OutputRingBuffers[0]->GetAvailableRead() : 0, std::memory_order_relaxed);
+		}
+	}
+
+	// Same pin/re-check as above, so SetProcessHook can wait for us to leave a hook it removed
+	IJackProcessHook* Hook = Self->ProcessHook.load(std::memory_order_seq_cst);
+	while (Hook)
+	{
+		Self->ProcessHookInUse.store(Hook, std::memory_order_seq_cst);
+		IJackProcessHook* Current = Self->ProcessHook.load(std::memory_order_seq_cst);
+		if (Current == Hook)
+		{
+			break;
+		}
+		Hook = Current;
+	}
+	if (Hook)
+	{
+		int32 NumOutputs = 0;
+		if (PortSet)
+		{
+			NumOutputs = PortSet->OutputPorts.Num();
+			for (int32 i = 0; i < NumOutputs; ++i)
+			{
+				PortSet->OutputPortBuffers[i] = PortSet->OutputConnections[i]->bConnected.load(std::memory_order_relaxed)
+					? static_cast<float*>(jack_port_get_buffer(PortSet->OutputPorts[i], NumFrames)) : nullptr;
+			}
+		}
+		Hook->OnJackProcess(PortSet ? PortSet->OutputPortBuffers.GetData() : nullptr, NumOutputs, NumFrames, SampleRate);
+	}
+	Self->ProcessHookInUse.store(nullptr, std::memory_order_release);
+	Self->RTPortSetInUse.store(nullptr, std::memory_order_release);
+	Self->LastCycleActivePorts.store(NumActivePorts, std::memory_order_relaxed);
+	Self->LastCycleRegisteredPorts.store(NumRegisteredPorts, std::memory_order_relaxed);
+
+	Self->CallbackTiming.Record(FPlatformTime::Cycles64() - EntryCycles, NumFrames, SampleRate);
+	return 0;
+#else
+	return 0;
+#endif
+}
+
+// Audio I/O methods
+static void WarnPerChannelIOInMultichannelMode()
+{
+	static bool bWarned = false;
+	if (!bWarned)
+	{
+		bWarned = true;
+		UE_LOG(LogJackAudioLink, Warning, TEXT("Per-channel audio I/O is not available with the multichannel ring; use ReadAudioFrames/WriteAudioFrames instead"));
+	}
+}
+
+bool FJackClientManager::ClaimChannels(bool bInput, TConstArrayView<int32> Channels, const void* Owner)
+{
+	FScopeLock Lock(&ChannelOwnerLock);
+	TArray<const void*>& Owners = bInput ? InputChannelOwners : OutputChannelOwners;
+#if WITH_JACK
+	// One shared cursor: a second owner anywhere in the direction would be a second producer/consumer
+	const FJackPortSetPtr PortSet = GetPortSet();
+	const bool bSharedRing = PortSet && (bInput ? PortSet->InputBlockRing.IsValid() : PortSet->OutputBlockRing.IsValid());
+#else
+	const bool bSharedRing = false;
+#endif
+	for (int32 Channel = 0; Channel < Owners.Num(); ++Channel)
+	{
+		if (Owners[Channel] && Owners[Channel] != Owner && (bSharedRing || Channels.Contains(Channel)))
+		{
+			UE_LOG(LogJackAudioLink, Warning, TEXT("%s channel %d is already streamed from the audio render thread; it cannot take a second %s"),
+				bInput ? TEXT("Input") : TEXT("Output"), Channel, bInput ? TEXT("reader") : TEXT("writer"));
+			return false;
+		}
+	}
+	for (const int32 Channel : Channels)
+	{
+		if (Channel < 0)
+		{
+			return false;
+		}
+	}
+	for (const int32 Channel : Channels)
+	{
+		if (Channel >= Owners.Num())
+		{
+			Owners.SetNumZeroed(Channel + 1);
+		}
+		Owners[Channel] = Owner;
+	}
+	return true;
+}
+
+void FJackClientManager::ReleaseChannels(bool bInput, const void* Owner)
+{
+	FScopeLock Lock(&ChannelOwnerLock);
+	for (const void*& ChannelOwner : bInput ? InputChannelOwners : OutputChannelOwners)
+	{
+		if (ChannelOwner == Owner)
+		{
+			ChannelOwner = nullptr;
+		}
+	}
+}
+
+bool FJackClientManager::CheckUnclaimed(bool bInput, TConstArrayView<int32> Channels, bool bSharedRing) const
+{
+	FScopeLock Lock(&ChannelOwnerLock);
+	const TArray<const void*>& Owners = bInput ? InputChannelOwners : OutputChannelOwners;
+	bool bClaimed = false;
+	for (int32 Channel = 0; Channel < Owners.Num() && !bClaimed; ++Channel)
+	{
+		bClaimed = Owners[Channel] && (bSharedRing || Channels.Contains(Channel));
+	}
+	if (bClaimed)
+	{
+		static bool bWarnedInput = false;
+		static bool bWarnedOutput = false;
+		bool& bWarned = bInput ? bWarnedInput : bWarnedOutput;
+		if (!bWarned)
+		{
+			bWarned = true;
+			UE_LOG(LogJackAudioLink, Warning, TEXT("Game-thread audio %s refused: the channel is streamed from the audio render thread (%s)"),
+				bInput ? TEXT("reads") : TEXT("writes"), bInput ? TEXT("input synth component") : TEXT("submix output"));
+		}
+	}
+	return !bClaimed;
+}
+
+TArray<float> FJackClientManager::ReadAudioBuffer(int32 ChannelIndex, int32 NumSamples)
+{
+	TArray<float> Result;
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputRingBuffers.IsValidIndex(ChannelIndex))
+	{
+		if (!CheckUnclaimed(true, MakeArrayView(&ChannelIndex, 1), false))
+		{
+			return Result;
+		}
+		if (NumSamples > 0)
+		{
+			AudioBufferAllocations.fetch_add(1, std::memory_order_relaxed);
+		}
+		Result.SetNumZeroed(NumSamples);
+		PortSet->InputRingBuffers[ChannelIndex]->Read(Result.GetData(), NumSamples);
+	}
+	else if (PortSet && PortSet->InputBlockRing.IsValid())
+	{
+		WarnPerChannelIOInMultichannelMode();
+	}
+#endif
+	return Result;
+}
+
+int32 FJackClientManager::ReadAudioBuffer(int32 ChannelIndex, TArrayView<float> OutSamples)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputRingBuffers.IsValidIndex(ChannelIndex) && CheckUnclaimed(true, MakeArrayView(&ChannelIndex, 1), false))
+	{
+		return PortSet->InputRingBuffers[ChannelIndex]->Read(OutSamples.GetData(), OutSamples.Num());
+	}
+	if (PortSet && PortSet->InputBlockRing.IsValid())
+	{
+		WarnPerChannelIOInMultichannelMode();
+	}
+#endif
+	FMemory::Memzero(OutSamples.GetData(), OutSamples.Num() * sizeof(float));
+	return 0;
+}
+
+int32 FJackClientManager::ReadAudioBuffer(int32 ChannelIndex, int32 NumSamples, TArray<float>& InOutBuffer)
+{
+	SizeAudioBuffer(InOutBuffer, NumSamples);
+	return ReadAudioBuffer(ChannelIndex, TArrayView<float>(InOutBuffer));
+}
+
+void FJackClientManager::SizeAudioBuffer(TArray<float>& Buffer, int32 NumSamples)
+{
+	NumSamples = FMath::Max(NumSamples, 0);
+	if (NumSamples > Buffer.Max())
+	{
+		AudioBufferAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	Buffer.SetNumUninitialized(NumSamples, EAllowShrinking::No);
+}
+
+bool FJackClientManager::WriteAudioBuffer(int32 ChannelIndex, const TArray<float>& AudioData)
+{
+	return WriteAudioBuffer(ChannelIndex, TConstArrayView<float>(AudioData));
+}
+
+bool FJackClientManager::WriteAudioBuffer(int32 ChannelIndex, TConstArrayView<float> AudioData)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->OutputRingBuffers.IsValidIndex(ChannelIndex))
+	{
+		if (!CheckUnclaimed(false, MakeArrayView(&ChannelIndex, 1), false))
+		{
+			return false;
+		}
+		PortSet->OutputRingBuffers[ChannelIndex]->Write(AudioData.GetData(), AudioData.Num());
+		return true;
+	}
+	if (PortSet && PortSet->OutputBlockRing.IsValid())
+	{
+		WarnPerChannelIOInMultichannelMode();
+	}
+#endif
+	return false;
+}
+
+float FJackClientManager::GetInputLevel(int32 ChannelIndex) const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputMeters.IsValidIndex(ChannelIndex))
+	{
+		return PortSet->InputMeters[ChannelIndex]->GetRMS();
+	}
+#endif
+	return 0.0f;
+}
+
+float FJackClientManager::GetInputPeakLevel(int32 ChannelIndex) const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputMeters.IsValidIndex(ChannelIndex))
+	{
+		return PortSet->InputMeters[ChannelIndex]->GetPeak();
+	}
+#endif
+	return 0.0f;
+}
+
+void FJackClientManager::SetMeteringParameters(float IntegrationWindowSeconds, float PeakDecayDbPerSecond)
+{
+	MeterIntegrationWindowSeconds.store(FMath::Max(IntegrationWindowSeconds, 0.0f), std::memory_order_relaxed);
+	MeterPeakDecayDbPerSecond.store(FMath::Max(PeakDecayDbPerSecond, 0.0f), std::memory_order_relaxed);
+}
+
+// Copies Count samples of one channel between a ring region and a strided destination/source.
+// RegionStride is the distance between consecutive samples of the channel inside the region.
+static void GatherFromRegion(const FJackAudioRingRegion& Region, int32 RegionOffset, int32 RegionStride, float* Dst, int32 DstStride, int32 Count)
+{
+	int32 Frame = 0;
+	for (const TArrayView<float>& Span : { Region.First, Region.Second })
+	{
+		const int32 SpanFrames = Span.Num() / RegionStride;
+		for (int32 i = 0; i < SpanFrames && Frame < Count; ++i, ++Frame)
+		{
+			Dst[Frame * DstStride] = Span[i * RegionStride + RegionOffset];
+		}
+	}
+}
+
+static void ScatterToRegion(const FJackAudioRingRegion& Region, int32 RegionOffset, int32 RegionStride, const float* Src, int32 SrcStride, int32 Count)
+{
+	int32 Frame = 0;
+	for (const TArrayView<float>& Span : { Region.First, Region.Second })
+	{
+		const int32 SpanFrames = Span.Num() / RegionStride;
+		for (int32 i = 0; i < SpanFrames && Frame < Count; ++i, ++Frame)
+		{
+			Span[i * RegionStride + RegionOffset] = Src ? Src[Frame * SrcStride] : 0.0f;
+		}
+	}
+}
+
+int32 FJackClientManager::ReadAudioFrames(TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TArrayView<float> OutSamples)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (!PortSet || !CheckUnclaimed(true, Channels, PortSet->InputBlockRing.IsValid()))
+	{
+		return 0;
+	}
+	return ReadAudioFrames(*PortSet, Channels, NumFrames, bInterleaved, OutSamples);
+#else
+	return 0;
+#endif
+}
+
+#if WITH_JACK
+int32 FJackClientManager::ReadAudioFrames(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TArrayView<float> OutSamples)
+{
+	const int32 NumChannels = Channels.Num();
+	if (NumFrames <= 0 || NumChannels == 0 || OutSamples.Num() < NumChannels * NumFrames)
+	{
+		return 0;
+	}
+	const int32 NumAvailableChannels = PortSet.InputBlockRing.IsValid() ? PortSet.InputBlockRing->GetNumChannels() : PortSet.InputRingBuffers.Num();
+	for (const int32 Channel : Channels)
+	{
+		if (Channel < 0 || Channel >= NumAvailableChannels)
+		{
+			return 0;
+		}
+	}
+	// Interleaved: sample (Frame, k) at Frame * NumChannels + k. Planar: at k * NumFrames + Frame.
+	const int32 FrameStride = bInterleaved ? NumChannels : 1;
+	const int32 ChannelStride = bInterleaved ? 1 : NumFrames;
+
+	int32 FramesRead = 0;
+	if (PortSet.InputBlockRing.IsValid())
+	{
+		const FJackAudioRingRegion Region = PortSet.InputBlockRing->PeekReadFrames(NumFrames);
+		FramesRead = Region.Num() / NumAvailableChannels;
+		for (int32 k = 0; k < NumChannels; ++k)
+		{
+			GatherFromRegion(Region, Channels[k], NumAvailableChannels, OutSamples.GetData() + k * ChannelStride, FrameStride, FramesRead);
+		}
+		PortSet.InputBlockRing->CommitReadFrames(FramesRead);
+	}
+	else
+	{
+		// Only consume what every selected channel can deliver, so the channels stay aligned
+		FramesRead = NumFrames;
+		for (const int32 Channel : Channels)
+		{
+			FramesRead = FMath::Min(FramesRead, PortSet.InputRingBuffers[Channel]->GetAvailableRead());
+		}
+		for (int32 k = 0; k < NumChannels; ++k)
+		{
+			FAudioRingBuffer& Ring = *PortSet.InputRingBuffers[Channels[k]];
+			if (bInterleaved)
+			{
+				GatherFromRegion(Ring.PeekRead(FramesRead), 0, 1, OutSamples.GetData() + k, FrameStride, FramesRead);
+				Ring.CommitRead(FramesRead);
+			}
+			else
+			{
+				Ring.Read(OutSamples.GetData() + k * ChannelStride, FramesRead);
+			}
+		}
+	}
+
+	// Zero the frames nobody could deliver
+	for (int32 k = 0; k < NumChannels; ++k)
+	{
+		for (int32 Frame = FramesRead; Frame < NumFrames; ++Frame)
+		{
+			OutSamples[k * ChannelStride + Frame * FrameStride] = 0.0f;
+		}
+	}
+	return FramesRead;
+}
+#endif
+
+#if WITH_JACK
+// Shared body of the frame writers: output channel Channels[k] takes GetSource(k)[Frame * FrameStride]
+template <typename SourceFuncType>
+static int32 WriteOutputFrames(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, int32 NumFrames, int32 FrameStride, SourceFuncType GetSource)
+{
+	const int32 NumChannels = Channels.Num();
+	const int32 NumAvailableChannels = PortSet.OutputBlockRing.IsValid() ? PortSet.OutputBlockRing->GetNumChannels() : PortSet.OutputRingBuffers.Num();
+	for (const int32 Channel : Channels)
+	{
+		if (Channel < 0 || Channel >= NumAvailableChannels)
+		{
+			return 0;
+		}
+	}
+
+	if (PortSet.OutputBlockRing.IsValid())
+	{
+		const FJackAudioRingRegion Region = PortSet.OutputBlockRing->PeekWriteFrames(NumFrames);
+		const int32 FramesWritten = Region.Num() / NumAvailableChannels;
+		if (NumChannels < NumAvailableChannels)
+		{
+			// Unselected channels still advance with the shared cursor; make them silent
+			FMemory::Memzero(Region.First.GetData(), Region.First.Num() * sizeof(float));
+			FMemory::Memzero(Region.Second.GetData(), Region.Second.Num() * sizeof(float));
+		}
+		for (int32 k = 0; k < NumChannels; ++k)
+		{
+			ScatterToRegion(Region, Channels[k], NumAvailableChannels, GetSource(k), FrameStride, FramesWritten);
+		}
+		PortSet.OutputBlockRing->CommitWriteFrames(FramesWritten);
+		return FramesWritten;
+	}
+
+	int32 FramesWritten = NumFrames;
+	for (const int32 Channel : Channels)
+	{
+		FramesWritten = FMath::Min(FramesWritten, PortSet.OutputRingBuffers[Channel]->GetAvailableWrite());
+	}
+	for (int32 k = 0; k < NumChannels; ++k)
+	{
+		FAudioRingBuffer& Ring = *PortSet.OutputRingBuffers[Channels[k]];
+		if (FrameStride == 1)
+		{
+			Ring.Write(GetSource(k), FramesWritten);
+		}
+		else
+		{
+			ScatterToRegion(Ring.PeekWrite(FramesWritten), 0, 1, GetSource(k), FrameStride, FramesWritten);
+			Ring.CommitWrite(FramesWritten);
+		}
+	}
+	return FramesWritten;
+}
+#endif
+
+int32 FJackClientManager::WriteAudioFrames(TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TConstArrayView<float> Samples)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	const int32 NumChannels = Channels.Num();
+	if (!PortSet || NumFrames <= 0 || NumChannels == 0 || Samples.Num() < NumChannels * NumFrames
+		|| !CheckUnclaimed(false, Channels, PortSet->OutputBlockRing.IsValid()))
+	{
+		return 0;
+	}
+	const int32 FrameStride = bInterleaved ? NumChannels : 1;
+	const int32 ChannelStride = bInterleaved ? 1 : NumFrames;
+	return WriteOutputFrames(*PortSet, Channels, NumFrames, FrameStride, [&Samples, ChannelStride](int32 k) { return Samples.GetData() + k * ChannelStride; });
+#else
+	return 0;
+#endif
+}
+
+int32 FJackClientManager::WriteInterleavedFrames(TConstArrayView<int32> Channels, TConstArrayView<int32> SourceChannels, int32 FrameStride, int32 NumFrames, const float* Frames)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (!PortSet || !CheckUnclaimed(false, Channels, PortSet->OutputBlockRing.IsValid()))
+	{
+		return 0;
+	}
+	return WriteInterleavedFrames(*PortSet, Channels, SourceChannels, FrameStride, NumFrames, Frames);
+#else
+	return 0;
+#endif
+}
+
+#if WITH_JACK
+int32 FJackClientManager::WriteInterleavedFrames(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, TConstArrayView<int32> SourceChannels, int32 FrameStride, int32 NumFrames, const float* Frames)
+{
+	if (!Frames || NumFrames <= 0 || Channels.Num() == 0 || SourceChannels.Num() != Channels.Num())
+	{
+		return 0;
+	}
+	for (const int32 Source : SourceChannels)
+	{
+		if (Source < 0 || Source >= FrameStride)
+		{
+			return 0;
+		}
+	}
+	return WriteOutputFrames(PortSet, Channels, NumFrames, FrameStride, [Frames, &SourceChannels](int32 k) { return Frames + SourceChannels[k]; });
+}
+#endif
+
+bool FJackClientManager::IsUsingMultichannelRing() const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	return PortSet && PortSet->bUseMultichannelRing;
+#else
+	return false;
+#endif
+}
+
+void FJackClientManager::SetProcessHook(IJackProcessHook* Hook)
+{
+#if WITH_JACK
+	IJackProcessHook* Previous = ProcessHook.exchange(Hook, std::memory_order_seq_cst);
+	if (Previous && Previous != Hook)
+	{
+		// At most one cycle: the callback either saw the swap or is finishing with Previous
+		while (ProcessHookInUse.load(std::memory_order_seq_cst) == Previous)
+		{
+			FPlatformProcess::Yield();
+		}
+	}
+#endif
+}
+
+int32 FJackClientManager::TrimInputBacklog(TConstArrayView<int32> Channels, int32 MaxFrames)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (!PortSet || !CheckUnclaimed(true, Channels, PortSet->InputBlockRing.IsValid()))
+	{
+		return 0;
+	}
+	return TrimInputBacklog(*PortSet, Channels, MaxFrames);
+#else
+	return 0;
+#endif
+}
+
+#if WITH_JACK
+int32 FJackClientManager::TrimInputBacklog(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, int32 MaxFrames)
+{
+	MaxFrames = FMath::Max(MaxFrames, 0);
+	if (PortSet.InputBlockRing.IsValid())
+	{
+		FMultichannelAudioRingBuffer& Ring = *PortSet.InputBlockRing;
+		const int32 Excess = Ring.GetAvailableRead() - MaxFrames;
+		if (Excess <= 0)
+		{
+			return 0;
+		}
+		const int32 Dropped = Ring.PeekReadFrames(Excess).Num() / Ring.GetNumChannels();
+		Ring.CommitReadFrames(Dropped);
+		return Dropped;
+	}
+	int32 MaxDropped = 0;
+	for (const int32 Channel : Channels)
+	{
+		if (PortSet.InputRingBuffers.IsValidIndex(Channel))
+		{
+			FAudioRingBuffer& Ring = *PortSet.InputRingBuffers[Channel];
+			const int32 Excess = Ring.GetAvailableRead() - MaxFrames;
+			if (Excess > 0)
+			{
+				MaxDropped = FMath::Max(MaxDropped, Ring.Discard(Excess));
+			}
+		}
+	}
+	return MaxDropped;
+}
+#endif
+
+int32 FJackClientManager::GetNumInputChannels() const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	return PortSet ? PortSet->InputPorts.Num() : 0;
+#else
+	return 0;
+#endif
+}
+
+int32 FJackClientManager::GetNumOutputChannels() const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	return PortSet ? PortSet->OutputPorts.Num() : 0;
+#else
+	return 0;
+#endif
+}
+
+int32 FJackClientManager::GetBufferedFrames(bool bInput, int32 ChannelIndex) const
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	return PortSet ? GetRingFill(*PortSet, bInput, ChannelIndex) : 0;
+#else
+	return 0;
 #endif
 }
-void FJackClientManager::ClientRegistrationCallback(const char* Name, int Register, void* Arg)
+
+void FJackClientManager::SetSampleRateConversion(bool bInput, uint32 GameSampleRate)
 {
-#if WITH_JACK
-	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
-	if (!Self || !Self->JackClient || !Name) { return; }
-	const bool bRegistered = (Register != 0);
-	const FString ClientName = UTF8_TO_TCHAR(Name);
-	if (bRegistered)
+	uint32& RingSampleRate = bInput ? InputRingSampleRate : OutputRingSampleRate;
+	if (RingSampleRate == GameSampleRate)
 	{
-	// Filter out our own client to avoid noise
-	if (ClientName == Self->GetClientName()) { return; }
-	// Do not broadcast here: ports may not be registered yet. PortRegistrationCallback will announce with proper counts.
-	UE_LOG(LogJackAudioLink, Verbose, TEXT("Client registered: %s"), *ClientName);
+		return;
 	}
-	else
+	RingSampleRate = GameSampleRate;
+#if WITH_JACK
+	// Re-registering the same ports keeps them and their rings and swaps in a set with the new converters
+	if (const FJackPortSetPtr Current = GetPortSet())
 	{
-		if (Self->KnownClientsLogged.Contains(ClientName))
-		{
-			UE_LOG(LogJackAudioLink, Log, TEXT("Client unregistered: %s"), *ClientName);
-			Self->KnownClientsLogged.Remove(ClientName);
-			AsyncTask(ENamedThreads::GameThread, [ClientName]()
-			{
-				if (GEngine)
-				{
-					if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
-					{
-						Subsys->NotifyClientDisconnected(ClientName);
-					}
-				}
-			});
-		}
+		RegisterAudioPorts(Current->InputPorts.Num(), Current->OutputPorts.Num(), Current->BaseName, Current->bUseMultichannelRing);
 	}
 #endif
 }
 
-void FJackClientManager::Disconnect()
+uint32 FJackClientManager::GetRingSampleRate(bool bInput) const
 {
 #if WITH_JACK
-	if (JackClient)
+	if (const FJackPortSetPtr PortSet = GetPortSet())
 	{
-		// Deactivate first to halt callbacks, then unregister ports, then close client
-		jack_deactivate(JackClient);
-		UnregisterAllPorts();
-		jack_client_close(JackClient);
-		JackClient = nullptr;
+		return GetRingSampleRate(*PortSet, bInput);
 	}
 #endif
+	return GetSampleRate();
 }
 
-bool FJackClientManager::IsConnected() const
+int32 FJackClientManager::GetRingPeriodFrames(bool bInput) const
 {
-	return JackClient != nullptr;
+	const uint32 JackSampleRate = GetSampleRate();
+	const uint32 BufferSize = GetBufferSize();
+	if (JackSampleRate == 0)
+	{
+		return static_cast<int32>(BufferSize);
+	}
+	return static_cast<int32>(static_cast<uint64>(BufferSize) * GetRingSampleRate(bInput) / JackSampleRate);
 }
 
-bool FJackClientManager::RegisterAudioPorts(int32 NumInputs, int32 NumOutputs, const FString& BaseName)
-{
 #if WITH_JACK
-	if (!JackClient)
+uint32 FJackClientManager::GetRingSampleRate(const FJackPortSet& PortSet, bool bInput) const
+{
+	// Inputs are converted from the JACK rate, outputs to it
+	if (bInput && PortSet.InputConverter.IsValid())
 	{
-		return false;
+		return PortSet.InputConverter->GetOutputRate();
 	}
-	UnregisterAllPorts();
-	
-	// Create ring buffers for inputs and outputs
-	InputRingBuffers.Empty();
-	OutputRingBuffers.Empty();
-	
-	for (int32 i = 0; i < NumInputs; ++i)
+	if (!bInput && PortSet.OutputConverter.IsValid())
 	{
-		FString Name = FString::Printf(TEXT("%s_in_%d"), *BaseName, i + 1);
-		FTCHARToUTF8 NameUtf8(*Name);
-		jack_port_t* Port = jack_port_register(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
-		if (Port) 
-		{ 
-			InputPorts.Add(Port);
-			InputRingBuffers.Add(MakeUnique<FAudioRingBuffer>(8192));
-		}
+		return PortSet.OutputConverter->GetInputRate();
 	}
-	
-	for (int32 i = 0; i < NumOutputs; ++i)
+	return GetSampleRate();
+}
+
+int32 FJackClientManager::GetRingPeriodFrames(const FJackPortSet& PortSet, bool bInput) const
+{
+	const uint32 JackSampleRate = GetSampleRate();
+	const uint32 BufferSize = GetBufferSize();
+	if (JackSampleRate == 0)
 	{
-		FString Name = FString::Printf(TEXT("%s_out_%d"), *BaseName, i + 1);
-		FTCHARToUTF8 NameUtf8(*Name);
-		jack_port_t* Port = jack_port_register(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
-		if (Port) 
-		{ 
-			OutputPorts.Add(Port);
-			OutputRingBuffers.Add(MakeUnique<FAudioRingBuffer>(8192));
-		}
+		return static_cast<int32>(BufferSize);
 	}
-	return true;
-#else
-	return false;
-#endif
+	return static_cast<int32>(static_cast<uint64>(BufferSize) * GetRingSampleRate(PortSet, bInput) / JackSampleRate);
 }
+#endif
 
-void FJackClientManager::UnregisterAllPorts()
+FJackAudioRingRegion FJackClientManager::PeekInputBuffer(int32 ChannelIndex, int32 MaxSamples)
 {
 #if WITH_JACK
-	for (jack_port_t* Port : InputPorts)
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputRingBuffers.IsValidIndex(ChannelIndex) && CheckUnclaimed(true, MakeArrayView(&ChannelIndex, 1), false))
 	{
-		if (Port && JackClient) { jack_port_unregister(JackClient, Port); }
+		return PortSet->InputRingBuffers[ChannelIndex]->PeekRead(MaxSamples);
 	}
-	for (jack_port_t* Port : OutputPorts)
+#endif
+	return FJackAudioRingRegion();
+}
+
+void FJackClientManager::CommitInputBuffer(int32 ChannelIndex, int32 NumSamples)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputRingBuffers.IsValidIndex(ChannelIndex) && CheckUnclaimed(true, MakeArrayView(&ChannelIndex, 1), false))
 	{
-		if (Port && JackClient) { jack_port_unregister(JackClient, Port); }
+		PortSet->InputRingBuffers[ChannelIndex]->CommitRead(NumSamples);
 	}
-	InputPorts.Empty();
-	OutputPorts.Empty();
-	InputRingBuffers.Empty();
-	OutputRingBuffers.Empty();
 #endif
 }
 
-// JACK Process Callback - This runs in real-time thread
-int FJackClientManager::ProcessCallback(jack_nframes_t NumFrames, void* Arg)
+FJackAudioRingRegion FJackClientManager::PeekOutputBuffer(int32 ChannelIndex, int32 MaxSamples)
 {
 #if WITH_JACK
-	FJackClientManager* Self = static_cast<FJackClientManager*>(Arg);
-	if (!Self || !Self->JackClient)
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->OutputRingBuffers.IsValidIndex(ChannelIndex) && CheckUnclaimed(false, MakeArrayView(&ChannelIndex, 1), false))
 	{
-		return 0;
+		return PortSet->OutputRingBuffers[ChannelIndex]->PeekWrite(MaxSamples);
 	}
+#endif
+	return FJackAudioRingRegion();
+}
 
-	// Process input ports
-	for (int32 i = 0; i < Self->InputPorts.Num(); ++i)
+void FJackClientManager::CommitOutputBuffer(int32 ChannelIndex, int32 NumSamples)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->OutputRingBuffers.IsValidIndex(ChannelIndex) && CheckUnclaimed(false, MakeArrayView(&ChannelIndex, 1), false))
 	{
-		if (Self->InputPorts[i] && Self->InputRingBuffers.IsValidIndex(i))
-		{
-			jack_default_audio_sample_t* InBuffer = static_cast<jack_default_audio_sample_t*>(
-				jack_port_get_buffer(Self->InputPorts[i], NumFrames));
-			if (InBuffer)
-			{
-				Self->InputRingBuffers[i]->Write(InBuffer, NumFrames);
-			}
-		}
+		PortSet->OutputRingBuffers[ChannelIndex]->CommitWrite(NumSamples);
 	}
+#endif
+}
 
-	// Process output ports
-	for (int32 i = 0; i < Self->OutputPorts.Num(); ++i)
+FJackAudioRingRegion FJackClientManager::PeekInputFrames(int32 MaxFrames)
+{
+#if WITH_JACK
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputBlockRing.IsValid() && CheckUnclaimed(true, {}, true))
 	{
-		if (Self->OutputPorts[i] && Self->OutputRingBuffers.IsValidIndex(i))
-		{
-			jack_default_audio_sample_t* OutBuffer = static_cast<jack_default_audio_sample_t*>(
-				jack_port_get_buffer(Self->OutputPorts[i], NumFrames));
-			if (OutBuffer)
-			{
-				// Read from ring buffer to output
-				Self->OutputRingBuffers[i]->Read(OutBuffer, NumFrames);
-			}
-		}
+		return PortSet->InputBlockRing->PeekReadFrames(MaxFrames);
 	}
-
-	return 0;
-#else
-	return 0;
 #endif
+	return FJackAudioRingRegion();
 }
 
-// Audio I/O methods
-TArray<float> FJackClientManager::ReadAudioBuffer(int32 ChannelIndex, int32 NumSamples)
+void FJackClientManager::CommitInputFrames(int32 NumFrames)
 {
-	TArray<float> Result;
 #if WITH_JACK
-	if (InputRingBuffers.IsValidIndex(ChannelIndex) && InputRingBuffers[ChannelIndex].IsValid())
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->InputBlockRing.IsValid() && CheckUnclaimed(true, {}, true))
 	{
-		Result.SetNumZeroed(NumSamples);
-		InputRingBuffers[ChannelIndex]->Read(Result.GetData(), NumSamples);
+		PortSet->InputBlockRing->CommitReadFrames(NumFrames);
 	}
 #endif
-	return Result;
 }
 
-bool FJackClientManager::WriteAudioBuffer(int32 ChannelIndex, const TArray<float>& AudioData)
+FJackAudioRingRegion FJackClientManager::PeekOutputFrames(int32 MaxFrames)
 {
 #if WITH_JACK
-	if (OutputRingBuffers.IsValidIndex(ChannelIndex) && OutputRingBuffers[ChannelIndex].IsValid())
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->OutputBlockRing.IsValid() && CheckUnclaimed(false, {}, true))
 	{
-		OutputRingBuffers[ChannelIndex]->Write(AudioData.GetData(), AudioData.Num());
-		return true;
+		return PortSet->OutputBlockRing->PeekWriteFrames(MaxFrames);
 	}
 #endif
-	return false;
+	return FJackAudioRingRegion();
 }
 
-float FJackClientManager::GetInputLevel(int32 ChannelIndex) const
+void FJackClientManager::CommitOutputFrames(int32 NumFrames)
 {
 #if WITH_JACK
-	if (InputRingBuffers.IsValidIndex(ChannelIndex) && InputRingBuffers[ChannelIndex].IsValid())
+	const FJackPortSetPtr PortSet = GetPortSet();
+	if (PortSet && PortSet->OutputBlockRing.IsValid() && CheckUnclaimed(false, {}, true))
 	{
-		return InputRingBuffers[ChannelIndex]->GetRMSLevel();
+		PortSet->OutputBlockRing->CommitWriteFrames(NumFrames);
 	}
 #endif
-	return 0.0f;
 }
 
 TArray<FString> FJackClientManager::GetAvailablePorts(const FString& NamePattern, const FString& TypePattern, uint32 Flags) const
@@ -438,7 +1722,13 @@ bool FJackClientManager::Activate()
 {
 #if WITH_JACK
 	if (!JackClient) { return false; }
-	return jack_activate(JackClient) == 0;
+	if (jack_activate(JackClient) != 0)
+	{
+		return false;
+	}
+	// Callbacks keep the graph index current from here on; take the starting point once
+	RebuildGraphIndex();
+	return true;
 #else
 	return false;
 #endif
@@ -480,56 +1770,22 @@ void FJackClientManager::PortRegistrationCallback(unsigned int PortId, int Regis
 		return;
 	}
 
-	if (bRegistered)
+	// Only resolve and queue here: the index update and any announcement happen on the graph event worker,
+	// which coalesces the burst of events a many-port client produces
+	if (!Self->GraphEventWorker)
 	{
-		// New/added port: if first time we see client, announce connect
-		if (!Self->KnownClientsLogged.Contains(ClientName))
-		{
-			TArray<FString> Inputs = Self->GetClientInputPorts(ClientName);
-			TArray<FString> Outputs = Self->GetClientOutputPorts(ClientName);
-			const int32 NumIn = Inputs.Num();
-			const int32 NumOut = Outputs.Num();
-			UE_LOG(LogJackAudioLink, Log, TEXT("Client connected: %s (in:%d, out:%d)"), *ClientName, NumIn, NumOut);
-			Self->KnownClientsLogged.Add(ClientName);
-			// Fire subsystem event on game thread
-			AsyncTask(ENamedThreads::GameThread, [ClientName, NumIn, NumOut]()
-			{
-				if (GEngine)
-				{
-					if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
-					{
-						Subsys->NotifyClientConnected(ClientName, NumIn, NumOut);
-					}
-				}
-			});
-			// Optional auto-connect
-			Self->AutoConnectToClient(ClientName);
-		}
+		return;
 	}
-	else
+	FJackGraphEvent Event;
+	Event.Type = bRegistered ? FJackGraphEvent::EType::PortRegistered : FJackGraphEvent::EType::PortUnregistered;
+	Event.ClientName = MoveTemp(ClientName);
+	Event.Name = MoveTemp(PortFull);
+	if (bRegistered)
 	{
-		// A port was unregistered; if client has no more ports, consider it disconnected
-		TArray<FString> Inputs = Self->GetClientInputPorts(ClientName);
-		TArray<FString> Outputs = Self->GetClientOutputPorts(ClientName);
-		if (Inputs.Num() == 0 && Outputs.Num() == 0)
-		{
-			if (Self->KnownClientsLogged.Contains(ClientName))
-			{
-				UE_LOG(LogJackAudioLink, Log, TEXT("Client disconnected: %s"), *ClientName);
-				Self->KnownClientsLogged.Remove(ClientName);
-				AsyncTask(ENamedThreads::GameThread, [ClientName]()
-				{
-					if (GEngine)
-					{
-						if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
-						{
-							Subsys->NotifyClientDisconnected(ClientName);
-						}
-					}
-				});
-			}
-		}
+		Event.bInput = (jack_port_flags(Port) & JackPortIsInput) != 0;
+		Event.bAudio = FCStringAnsi::Strcmp(jack_port_type(Port), JACK_DEFAULT_AUDIO_TYPE) == 0;
 	}
+	Self->GraphEventWorker->Enqueue(MoveTemp(Event));
 #endif
 }
 
@@ -549,34 +1805,19 @@ void FJackClientManager::AutoConnectToClient(const FString& ClientName)
 
 TArray<FString> FJackClientManager::GetAllClients() const
 {
-    TArray<FString> Clients;
 #if WITH_JACK
-    if (!JackClient) { return Clients; }
-    const char** Ports = jack_get_ports(JackClient, nullptr, nullptr, 0);
-    if (Ports)
-    {
-        TSet<FString> Unique;
-        for (int i = 0; Ports[i] != nullptr; ++i)
-        {
-            FString PortName = UTF8_TO_TCHAR(Ports[i]);
-            FString Client;
-            if (PortName.Split(TEXT(":"), &Client, nullptr))
-            {
-                Unique.Add(Client);
-            }
-        }
-        Clients = Unique.Array();
-        jack_free(const_cast<char**>(Ports));
-    }
+    if (JackClient) { return GraphIndex.GetClients(); }
 #endif
-    return Clients;
+    return TArray<FString>();
 }
 
 TArray<FString> FJackClientManager::GetInputPortNames() const
 {
     TArray<FString> Names;
 #if WITH_JACK
-    for (jack_port_t* Port : InputPorts)
+    const FJackPortSetPtr PortSet = GetPortSet();
+    if (!PortSet) { return Names; }
+    for (jack_port_t* Port : PortSet->InputPorts)
     {
         if (Port && JackClient)
         {
@@ -589,40 +1830,218 @@ TArray<FString> FJackClientManager::GetInputPortNames() const
 
 TArray<FString> FJackClientManager::GetClientOutputPorts(const FString& ClientName) const
 {
-    TArray<FString> Ports;
 #if WITH_JACK
-    if (!JackClient) { return Ports; }
-	const FString Pattern = FString::Printf(TEXT("^(%s):.*$"), *EscapeRegex(ClientName));
-	FTCHARToUTF8 NameUtf8(*Pattern);
-    const char** CPorts = jack_get_ports(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput);
-    if (CPorts)
-    {
-        for (int i = 0; CPorts[i] != nullptr; ++i)
-        {
-            Ports.Add(UTF8_TO_TCHAR(CPorts[i]));
-        }
-        jack_free(const_cast<char**>(CPorts));
-    }
+	if (JackClient) { return GraphIndex.GetClientPorts(ClientName, false); }
 #endif
-    return Ports;
+	return TArray<FString>();
 }
 
 TArray<FString> FJackClientManager::GetClientInputPorts(const FString& ClientName) const
 {
-	TArray<FString> Ports;
 #if WITH_JACK
-	if (!JackClient) { return Ports; }
-	const FString Pattern = FString::Printf(TEXT("^(%s):.*$"), *EscapeRegex(ClientName));
-	FTCHARToUTF8 NameUtf8(*Pattern);
-	const char** CPorts = jack_get_ports(JackClient, NameUtf8.Get(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput);
-	if (CPorts)
+	if (JackClient) { return GraphIndex.GetClientPorts(ClientName, true); }
+#endif
+	return TArray<FString>();
+}
+
+int32 FJackClientManager::GetNumClientPorts(const FString& ClientName, bool bInput) const
+{
+#if WITH_JACK
+	if (JackClient) { return GraphIndex.GetNumClientPorts(ClientName, bInput); }
+#endif
+	return 0;
+}
+
+FString FJackClientManager::GetClientPort(const FString& ClientName, bool bInput, int32 PortIndex) const
+{
+#if WITH_JACK
+	if (JackClient) { return GraphIndex.GetClientPort(ClientName, bInput, PortIndex); }
+#endif
+	return FString();
+}
+
+TArray<FString> FJackClientManager::GetPortConnections(const FString& PortName) const
+{
+#if WITH_JACK
+	if (JackClient) { return GraphIndex.GetConnections(PortName); }
+#endif
+	return TArray<FString>();
+}
+
+TArray<FJackRoutingEdge> FJackClientManager::GetAllConnections() const
+{
+	TArray<FJackRoutingEdge> Edges;
+#if WITH_JACK
+	if (JackClient)
 	{
-		for (int i = 0; CPorts[i] != nullptr; ++i)
+		for (const TPair<FString, FString>& Connection : GraphIndex.GetAudioConnections())
 		{
-			Ports.Add(UTF8_TO_TCHAR(CPorts[i]));
+			Edges.Emplace(Connection.Key, Connection.Value);
 		}
-		jack_free(const_cast<char**>(CPorts));
 	}
 #endif
-	return Ports;
-}
\ No newline at end of file
+	return Edges;
+}
+
+TFuture<bool> FJackClientManager::ConnectPortsAsync(const FString& SourcePort, const FString& DestinationPort)
+{
+	return RunOnControlThread<bool>([this, SourcePort, DestinationPort]()
+	{
+		return ConnectPorts(SourcePort, DestinationPort);
+	});
+}
+
+TFuture<bool> FJackClientManager::DisconnectPortsAsync(const FString& SourcePort, const FString& DestinationPort)
+{
+	return RunOnControlThread<bool>([this, SourcePort, DestinationPort]()
+	{
+		return DisconnectPorts(SourcePort, DestinationPort);
+	});
+}
+
+TFuture<TArray<FString>> FJackClientManager::GetAvailablePortsAsync(const FString& NamePattern, const FString& TypePattern, uint32 Flags)
+{
+	return RunOnControlThread<TArray<FString>>([this, NamePattern, TypePattern, Flags]()
+	{
+		return GetAvailablePorts(NamePattern, TypePattern, Flags);
+	});
+}
+
+TFuture<FJackRoutingResult> FJackClientManager::ApplyRoutingMatrix(TArray<FJackRoutingEdge> Edges, EJackRoutingScope Scope)
+{
+#if WITH_JACK
+	if (JackClient && ControlThread)
+	{
+		return ControlThread->Submit<FJackRoutingResult>([this, Edges = MoveTemp(Edges), Scope]()
+		{
+			return ApplyRoutingMatrixNow(Edges, Scope);
+		});
+	}
+#endif
+	FJackRoutingResult Result;
+	for (const FJackRoutingEdge& Edge : Edges)
+	{
+		Result.Add(Edge, EJackRoutingEdgeResult::Failed);
+	}
+	return MakeFulfilledPromise<FJackRoutingResult>(MoveTemp(Result)).GetFuture();
+}
+
+#if WITH_JACK
+FJackRoutingResult FJackClientManager::ApplyRoutingMatrixNow(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope) const
+{
+	const double StartSeconds = FPlatformTime::Seconds();
+	FJackRoutingResult Result;
+
+	// Ports are looked up once each, however many edges use them
+	TMap<FString, jack_port_t*> PortsByName;
+	auto FindPort = [this, &PortsByName](const FString& Name) -> jack_port_t*
+	{
+		if (jack_port_t** Found = PortsByName.Find(Name))
+		{
+			return *Found;
+		}
+		return PortsByName.Add(Name, jack_port_by_name(JackClient, TCHAR_TO_UTF8(*Name)));
+	};
+
+	// Edges listed as (input, output) are turned around, so they diff against the live output -> input ones
+	TArray<FJackRoutingEdge> Wanted;
+	TSet<FJackRoutingEdge> WantedSet;
+	for (const FJackRoutingEdge& Listed : Edges)
+	{
+		FJackRoutingEdge Edge = Listed;
+		jack_port_t* Source = FindPort(Edge.SourcePort);
+		jack_port_t* Destination = FindPort(Edge.DestinationPort);
+		if (Source && Destination && (jack_port_flags(Source) & JackPortIsInput) && (jack_port_flags(Destination) & JackPortIsOutput))
+		{
+			Swap(Edge.SourcePort, Edge.DestinationPort);
+		}
+		bool bAlreadyListed = false;
+		WantedSet.Add(Edge, &bAlreadyListed);
+		if (!bAlreadyListed)
+		{
+			Wanted.Add(Edge);
+		}
+	}
+
+	// Live connections of the audio ports in scope, as output -> input edges. The matrix only describes
+	// audio, so MIDI and other port types are never scanned and their connections never broken.
+	TSet<FJackRoutingEdge> Current;
+	TSet<FString> VisitedPorts;
+	auto AddConnectionsOf = [this, &FindPort, &Current, &VisitedPorts](const FString& Name)
+	{
+		bool bVisited = false;
+		VisitedPorts.Add(Name, &bVisited);
+		jack_port_t* Port = bVisited ? nullptr : FindPort(Name);
+		if (!Port || FCStringAnsi::Strcmp(jack_port_type(Port), JACK_DEFAULT_AUDIO_TYPE) != 0)
+		{
+			return;
+		}
+		const bool bInput = (jack_port_flags(Port) & JackPortIsInput) != 0;
+		if (const char** Connections = jack_port_get_all_connections(JackClient, Port))
+		{
+			for (int i = 0; Connections[i] != nullptr; ++i)
+			{
+				const FString Other = UTF8_TO_TCHAR(Connections[i]);
+				Current.Add(bInput ? FJackRoutingEdge(Other, Name) : FJackRoutingEdge(Name, Other));
+			}
+			jack_free(const_cast<char**>(Connections));
+		}
+	};
+	if (Scope == EJackRoutingScope::WholeGraph)
+	{
+		if (const char** Outputs = jack_get_ports(JackClient, nullptr, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput))
+		{
+			for (int i = 0; Outputs[i] != nullptr; ++i)
+			{
+				AddConnectionsOf(UTF8_TO_TCHAR(Outputs[i]));
+			}
+			jack_free(const_cast<char**>(Outputs));
+		}
+	}
+	else
+	{
+		// Add-only only needs to know which wanted edges exist, which the sources alone tell
+		for (const FJackRoutingEdge& Edge : Wanted)
+		{
+			AddConnectionsOf(Edge.SourcePort);
+			if (Scope == EJackRoutingScope::ListedPorts)
+			{
+				AddConnectionsOf(Edge.DestinationPort);
+			}
+		}
+	}
+
+	// Break first, so a destination never briefly sums its old and new sources
+	if (Scope != EJackRoutingScope::AddOnly)
+	{
+		for (const FJackRoutingEdge& Edge : Current)
+		{
+			if (!WantedSet.Contains(Edge))
+			{
+				const int Error = jack_disconnect(JackClient, TCHAR_TO_UTF8(*Edge.SourcePort), TCHAR_TO_UTF8(*Edge.DestinationPort));
+				Result.Add(Edge, Error == 0 ? EJackRoutingEdgeResult::Disconnected : EJackRoutingEdgeResult::Failed);
+			}
+		}
+	}
+	for (const FJackRoutingEdge& Edge : Wanted)
+	{
+		if (Current.Contains(Edge))
+		{
+			Result.Add(Edge, EJackRoutingEdgeResult::Unchanged);
+			continue;
+		}
+		if (!FindPort(Edge.SourcePort) || !FindPort(Edge.DestinationPort))
+		{
+			Result.Add(Edge, EJackRoutingEdgeResult::MissingPort);
+			continue;
+		}
+		const int Error = jack_connect(JackClient, TCHAR_TO_UTF8(*Edge.SourcePort), TCHAR_TO_UTF8(*Edge.DestinationPort));
+		Result.Add(Edge, Error == 0 ? EJackRoutingEdgeResult::Connected : Error == EEXIST ? EJackRoutingEdgeResult::Unchanged : EJackRoutingEdgeResult::Failed);
+	}
+
+	Result.Milliseconds = static_cast<float>((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	UE_LOG(LogJackAudioLink, Log, TEXT("Routing matrix applied: %d connected, %d disconnected, %d unchanged, %d failed in %.2f ms"),
+		Result.NumConnected, Result.NumDisconnected, Result.NumUnchanged, Result.NumFailed, Result.Milliseconds);
+	return Result;
+}
+#endif
@@ -1,35 +1,99 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "HAL/CriticalSection.h"
 #include "Containers/CircularBuffer.h"
+#include "Containers/CircularQueue.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "JackAudioRingBuffer.h"
+#include "JackAudioMeter.h"
+#include "JackCallbackTiming.h"
+#include "JackGraphIndex.h"
+#include "JackGraphEventWorker.h"
+#include "JackControlThread.h"
+#include "JackRoutingTypes.h"
+#include "JackSampleRateConverter.h"
+#include "JackProcessHook.h"
 
 #if WITH_JACK
 #include <jack/jack.h>
 #include <jack/types.h>
 #endif
 
-// Audio ring buffer for thread-safe audio I/O
-class FAudioRingBuffer
+#if WITH_JACK
+// Connection state of one of our ports, kept current by the port-connect callback so the process
+// callback can skip ports nobody is connected to
+struct FJackPortConnection
 {
-public:
-    FAudioRingBuffer(int32 InCapacity = 8192) : Capacity(InCapacity), WritePos(0), ReadPos(0)
-    {
-        Buffer.SetNumZeroed(Capacity);
-    }
+	std::atomic<bool> bConnected{false};
+};
 
-    void Write(const float* Data, int32 NumSamples);
-    int32 Read(float* OutData, int32 NumSamples);
-    void Clear();
-    int32 GetAvailableRead() const;
-    float GetRMSLevel() const; // For debug level monitoring
+// Immutable snapshot of the registered ports and the rings/meters behind them. The process callback
+// reads the active snapshot without locking; RegisterAudioPorts builds a new one and swaps it in,
+// carrying over the ports (and their rings) that survive the change.
+struct FJackPortSet
+{
+	FString BaseName;
+	bool bUseMultichannelRing = false;
 
-private:
-    TArray<float> Buffer;
-    int32 Capacity;
-    std::atomic<int32> WritePos;
-    std::atomic<int32> ReadPos;
-    mutable FCriticalSection CriticalSection;
+	TArray<jack_port_t*> InputPorts;
+	TArray<jack_port_t*> OutputPorts;
+
+	// Per-port mode: one ring per port
+	TArray<TSharedPtr<FAudioRingBuffer>> InputRingBuffers;
+	TArray<TSharedPtr<FAudioRingBuffer>> OutputRingBuffers;
+
+	// Multichannel ring mode: one arena and cursor pair per direction
+	TSharedPtr<FMultichannelAudioRingBuffer> InputBlockRing;
+	TSharedPtr<FMultichannelAudioRingBuffer> OutputBlockRing;
+	// RT-owned scratch for port buffer pointers (block rings; outputs also for the process hook)
+	mutable TArray<float*> InputPortBuffers;
+	mutable TArray<float*> OutputPortBuffers;
+
+	// One meter per input port
+	TArray<TSharedPtr<FJackChannelMeter>> InputMeters;
+
+	// Sample-rate conversion between the JACK rate and the rate the game side uses for the rings of one
+	// direction (null when that direction runs at the JACK rate), with RT-owned planar scratch of
+	// ConvertStride floats per channel for the game-rate side of the block
+	TSharedPtr<FJackSampleRateConverter> InputConverter;
+	TSharedPtr<FJackSampleRateConverter> OutputConverter;
+	mutable TArray<float> InputConvertBuffer;
+	mutable TArray<float> OutputConvertBuffer;
+	mutable TArray<float*> ConvertChannels;
+	int32 InputConvertStride = 0;
+	int32 OutputConvertStride = 0;
+
+	// Parallel to InputPorts/OutputPorts; carried over with the ports
+	TArray<TSharedPtr<FJackPortConnection>> InputConnections;
+	TArray<TSharedPtr<FJackPortConnection>> OutputConnections;
+};
+using FJackPortSetPtr = TSharedPtr<const FJackPortSet>;
+
+// Signature of jack_port_get_buffer, so the process loop can also run on fake ports (benchmarks)
+using FJackGetPortBufferFunc = void* (*)(jack_port_t*, jack_nframes_t);
+#endif
+
+// One xrun as reported to this client, with the state of our own process path at that moment
+struct FJackXrunEvent
+{
+	uint64 SequenceNumber = 0;            // 1-based count of xruns since Connect
+	double PlatformSeconds = 0.0;         // FPlatformTime::Seconds() when the notification arrived
+	float DelayedMicroseconds = 0.0f;     // jack_get_xrun_delayed_usecs
+	uint32 FrameTime = 0;                 // jack_frame_time
+	uint64 LastCallbackNs = 0;            // Duration of our last process callback
+	float LastCallbackBudgetFraction = 0.0f;
+	int32 InputRingFill = 0;              // Readable samples in the first input ring (frames in multichannel mode) after the last cycle
+	int32 OutputRingFill = 0;             // Same for the first output ring
+};
+
+// Latency of one of our ports: the JACK range (upstream capture for inputs, downstream playback for
+// outputs) plus the samples currently buffered in its ring between JACK and the game
+struct FJackPortLatency
+{
+	int32 JackMinFrames = 0;
+	int32 JackMaxFrames = 0;
+	int32 RingFrames = 0;
 };
 
 class FJackClientManager
@@ -44,14 +108,18 @@ public:
 	bool Activate();
 	bool Deactivate();
 
-	bool RegisterAudioPorts(int32 NumInputs, int32 NumOutputs, const FString& BaseName);
+	// bUseMultichannelRing stores each direction in one FMultichannelAudioRingBuffer instead of one ring per port.
+	// Safe while the client is active: ports already registered under BaseName are kept, the rest are added or
+	// removed, and the process callback switches to the new set on its next cycle.
+	bool RegisterAudioPorts(int32 NumInputs, int32 NumOutputs, const FString& BaseName, bool bUseMultichannelRing = false);
 	void UnregisterAllPorts();
 
 	TArray<FString> GetAvailablePorts(const FString& NamePattern = TEXT(""), const FString& TypePattern = TEXT(""), uint32 Flags = 0) const;
 	bool ConnectPorts(const FString& SourcePort, const FString& DestinationPort);
 	bool DisconnectPorts(const FString& SourcePort, const FString& DestinationPort);
 
-	// Discovery helpers
+	// Discovery helpers. Answered from the local graph index (no server round-trip); ports are listed in
+	// registration order and only audio ports count
 	TArray<FString> GetAllClients() const;
 	TArray<FString> GetInputPortNames() const;
 	TArray<FString> GetClientOutputPorts(const FString& ClientName) const;
@@ -62,7 +130,114 @@ public:
 	// Audio I/O methods
 	TArray<float> ReadAudioBuffer(int32 ChannelIndex, int32 NumSamples);
 	bool WriteAudioBuffer(int32 ChannelIndex, const TArray<float>& AudioData);
-	float GetInputLevel(int32 ChannelIndex) const; // For debug monitoring
+
+	// Allocation-free variants. Reads fill the caller's storage (zero-padded) and return the samples actually read;
+	// the TArray overload resizes without shrinking, so a buffer reused every tick only allocates on growth.
+	int32 ReadAudioBuffer(int32 ChannelIndex, TArrayView<float> OutSamples);
+	int32 ReadAudioBuffer(int32 ChannelIndex, int32 NumSamples, TArray<float>& InOutBuffer);
+	bool WriteAudioBuffer(int32 ChannelIndex, TConstArrayView<float> AudioData);
+
+	// Number of heap allocations made on behalf of audio I/O calls (returned arrays, growth of reused buffers).
+	// Stays constant in steady state when only the allocation-free variants are used.
+	uint64 GetAudioBufferAllocationCount() const { return AudioBufferAllocations.load(std::memory_order_relaxed); }
+	// Sizes a caller's reused buffer to NumSamples (never shrinking its storage), counting any growth above
+	void SizeAudioBuffer(TArray<float>& Buffer, int32 NumSamples);
+
+	// Input metering, computed by the process callback from the port buffers (both ring modes).
+	// Lock-free loads; RMS is averaged over the integration window, the peak is held and falls linearly in dB.
+	float GetInputLevel(int32 ChannelIndex) const;
+	float GetInputPeakLevel(int32 ChannelIndex) const;
+	void SetMeteringParameters(float IntegrationWindowSeconds, float PeakDecayDbPerSecond);
+
+	// Batched frame I/O over a set of channels (0-based), interleaved or planar (channel-major).
+	// Every selected channel moves the same number of frames, which is returned, so the block stays
+	// sample-aligned; missing frames are zeroed on read. Works in both ring modes. With the multichannel
+	// ring the shared cursor advances for all channels: unselected inputs are dropped, unselected outputs get silence.
+	int32 ReadAudioFrames(TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TArrayView<float> OutSamples);
+	int32 WriteAudioFrames(TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TConstArrayView<float> Samples);
+	// Same as an interleaved WriteAudioFrames from a wider frame layout (e.g. a submix buffer): output channel
+	// Channels[k] takes sample SourceChannels[k] of each FrameStride-float frame. Allocation-free.
+	int32 WriteInterleavedFrames(TConstArrayView<int32> Channels, TConstArrayView<int32> SourceChannels, int32 FrameStride, int32 NumFrames, const float* Frames);
+	bool IsUsingMultichannelRing() const;
+	// Consumer side: drops the oldest input frames on Channels so at most MaxFrames stay buffered; returns the most dropped
+	int32 TrimInputBacklog(TConstArrayView<int32> Channels, int32 MaxFrames);
+	int32 GetNumInputChannels() const;
+	int32 GetNumOutputChannels() const;
+	// Frames queued in the ring of a channel (0-based) right now; with the multichannel ring, of the shared one
+	int32 GetBufferedFrames(bool bInput, int32 ChannelIndex) const;
+
+	// Per-direction sample-rate conversion: the input (or output) rings then hold audio at GameSampleRate and the
+	// process callback converts from (or to) the JACK rate. 0, or the JACK rate, turns it off. Re-registers the
+	// current ports to apply; also applies to later registrations.
+	void SetSampleRateConversion(bool bInput, uint32 GameSampleRate);
+	// Rate of the audio in the input or output rings: the JACK rate unless converted
+	uint32 GetRingSampleRate(bool bInput) const;
+	// One JACK period in frames of that ring's rate (what the process callback moves per cycle on average)
+	int32 GetRingPeriodFrames(bool bInput) const;
+
+	// Channels streamed from the audio render thread (the submix output bridge, input synth components). A ring
+	// takes one producer and one consumer, so while a channel is claimed the game-thread I/O calls above refuse it
+	// with a warning and only its owner touches it, through the FJackPortSet overloads below. With the multichannel
+	// ring every channel of a direction shares one cursor, so a claim on any of them closes the whole direction.
+	// Claim fails when another owner holds one of the channels. Both take a lock, so not per render block.
+	bool ClaimChannels(bool bInput, TConstArrayView<int32> Channels, const void* Owner);
+	void ReleaseChannels(bool bInput, const void* Owner);
+
+#if WITH_JACK
+	// Audio render thread access. The active port set only changes when its generation does, so a render
+	// callback can keep the set it got from GetPortSet across blocks and pass it to the overloads below,
+	// instead of every call taking PortSetLock (and contending with re-registration on the game thread).
+	FJackPortSetPtr GetPortSet() const;
+	uint32 GetPortSetGeneration() const { return PortSetGeneration.load(std::memory_order_acquire); }
+	static int32 ReadAudioFrames(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, int32 NumFrames, bool bInterleaved, TArrayView<float> OutSamples);
+	static int32 WriteInterleavedFrames(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, TConstArrayView<int32> SourceChannels, int32 FrameStride, int32 NumFrames, const float* Frames);
+	static int32 TrimInputBacklog(const FJackPortSet& PortSet, TConstArrayView<int32> Channels, int32 MaxFrames);
+	static int32 GetBufferedFrames(const FJackPortSet& PortSet, bool bInput, int32 ChannelIndex) { return GetRingFill(PortSet, bInput, ChannelIndex); }
+	uint32 GetRingSampleRate(const FJackPortSet& PortSet, bool bInput) const;
+	int32 GetRingPeriodFrames(const FJackPortSet& PortSet, bool bInput) const;
+#endif
+
+	// Zero-copy ring access (see FJackAudioRingRegion). The game side reads input regions and fills output
+	// regions in place; Commit then consumes/publishes the first N samples of the last Peek on that channel.
+	FJackAudioRingRegion PeekInputBuffer(int32 ChannelIndex, int32 MaxSamples);
+	void CommitInputBuffer(int32 ChannelIndex, int32 NumSamples);
+	FJackAudioRingRegion PeekOutputBuffer(int32 ChannelIndex, int32 MaxSamples);
+	void CommitOutputBuffer(int32 ChannelIndex, int32 NumSamples);
+
+	// Multichannel ring mode: same as above over interleaved frames of every channel
+	FJackAudioRingRegion PeekInputFrames(int32 MaxFrames);
+	void CommitInputFrames(int32 NumFrames);
+	FJackAudioRingRegion PeekOutputFrames(int32 MaxFrames);
+	void CommitOutputFrames(int32 NumFrames);
+
+	// Ports the last process cycle actually touched (connected ones) vs. ports registered
+	int32 GetActivePortCount() const { return LastCycleActivePorts.load(std::memory_order_relaxed); }
+	int32 GetRegisteredPortCount() const { return LastCycleRegisteredPorts.load(std::memory_order_relaxed); }
+
+	// Wall time of our own process callback, entry to exit, and its share of the cycle period.
+	// Unlike GetCpuLoad (the whole server), this isolates the cost of this client.
+	FJackCallbackTimingSnapshot GetCallbackTiming() const { return CallbackTiming.GetSnapshot(); }
+	void ResetCallbackTiming() { CallbackTiming.RequestReset(); }
+	void SetCallbackBudgetThreshold(float Fraction) { CallbackTiming.SetBudgetThreshold(Fraction); }
+
+	// Capture->game latency of an input channel, or game->playback latency of an output channel (0-based).
+	// Ring occupancy is sampled at the time of the call.
+	bool GetPortLatency(bool bInput, int32 ChannelIndex, FJackPortLatency& OutLatency) const;
+
+	// See FJackProcessHooks::SetHook
+	void SetProcessHook(IJackProcessHook* Hook);
+
+	// Xruns since Connect. Every xrun is counted; the details go through a fixed-size lock-free queue
+	// that the game thread drains (single consumer), and are dropped if it falls more than a queue behind.
+	uint64 GetXrunCount() const { return XrunCount.load(std::memory_order_relaxed); }
+	bool DequeueXrunEvent(FJackXrunEvent& OutEvent) { return XrunEvents.Dequeue(OutEvent); }
+
+#if WITH_JACK
+	// RT body of the process callback for one port set; returns the number of ports it processed
+	static int32 ProcessPortSet(const FJackPortSet& Set, jack_nframes_t NumFrames, const FJackMeterCoefficients& MeterCoefficients, FJackGetPortBufferFunc GetPortBuffer);
+	// Gives a port set being built converters between JackSampleRate and the game-side rates (0 = none)
+	static void SetUpRateConversion(FJackPortSet& Set, uint32 JackSampleRate, uint32 InputGameSampleRate, uint32 OutputGameSampleRate);
+#endif
 
 	// Info
 	FString GetClientName() const;
@@ -72,6 +247,35 @@ public:
 
 	// Per-client port queries
 	TArray<FString> GetClientInputPorts(const FString& ClientName) const;
+	int32 GetNumClientPorts(const FString& ClientName, bool bInput) const;
+	// 0-based position in GetClientInputPorts/GetClientOutputPorts; empty when out of range
+	FString GetClientPort(const FString& ClientName, bool bInput, int32 PortIndex) const;
+	// Ports connected to a port (full names), per the graph index
+	TArray<FString> GetPortConnections(const FString& PortName) const;
+	// Every audio connection in the graph, per the graph index
+	TArray<FJackRoutingEdge> GetAllConnections() const;
+
+	// Makes the live connections match Edges within Scope. Runs on the control thread: the current connections
+	// of the ports in scope are read from JACK, and only the difference is connected/disconnected. The future
+	// is fulfilled there with a result per touched edge; without a client every edge is Failed.
+	TFuture<FJackRoutingResult> ApplyRoutingMatrix(TArray<FJackRoutingEdge> Edges, EJackRoutingScope Scope);
+
+	// Runs Task on the control thread, after the routing work queued before it, and fulfils the future there.
+	// Without a client (no control thread) it runs right away on the calling thread. Call from the game thread.
+	template<typename ResultType>
+	TFuture<ResultType> RunOnControlThread(TUniqueFunction<ResultType()>&& Task)
+	{
+		if (ControlThread)
+		{
+			return ControlThread->Submit<ResultType>(MoveTemp(Task));
+		}
+		return MakeFulfilledPromise<ResultType>(Task()).GetFuture();
+	}
+
+	// jack_connect / jack_disconnect / jack_get_ports on the control thread
+	TFuture<bool> ConnectPortsAsync(const FString& SourcePort, const FString& DestinationPort);
+	TFuture<bool> DisconnectPortsAsync(const FString& SourcePort, const FString& DestinationPort);
+	TFuture<TArray<FString>> GetAvailablePortsAsync(const FString& NamePattern = TEXT(""), const FString& TypePattern = TEXT(""), uint32 Flags = 0);
 
 private:
 	FJackClientManager();
@@ -80,14 +284,93 @@ private:
 	// JACK callbacks
 	static void ClientRegistrationCallback(const char* Name, int Register, void* Arg);
 	static void PortRegistrationCallback(unsigned int PortId, int Register, void* Arg);
+	static void PortConnectCallback(jack_port_id_t PortA, jack_port_id_t PortB, int Connect, void* Arg);
 	static int ProcessCallback(jack_nframes_t NumFrames, void* Arg);
+	static int XrunCallback(void* Arg);
+#if WITH_JACK
+	static void PortRenameCallback(jack_port_id_t Port, const char* OldName, const char* NewName, void* Arg);
+	static void LatencyCallback(jack_latency_callback_mode_t Mode, void* Arg);
+	// Samples buffered in the ring behind one of our ports (the shared ring in multichannel mode)
+	static int32 GetRingFill(const FJackPortSet& PortSet, bool bInput, int32 ChannelIndex);
+	// Delay the ring (and rate conversion) behind one of our ports adds, in JACK frames
+	static int32 GetRingLatency(const FJackPortSet& PortSet, bool bInput, int32 ChannelIndex);
+	// Largest ring latency over all ports of one direction
+	static int32 GetMaxRingLatency(const FJackPortSet& PortSet, bool bInput);
+	// RT bodies of ProcessPortSet for a direction with rate conversion; return the ports processed
+	static int32 ProcessConvertedInputs(const FJackPortSet& Set, jack_nframes_t NumFrames, const FJackMeterCoefficients& MeterCoefficients, FJackGetPortBufferFunc GetPortBuffer);
+	static int32 ProcessConvertedOutputs(const FJackPortSet& Set, jack_nframes_t NumFrames, FJackGetPortBufferFunc GetPortBuffer);
+	// Asks JACK to recompute graph latencies when our ring buffering drifted by a period or more
+	bool TickLatency(float DeltaTime);
+	// Lists the whole graph into GraphIndex; the callbacks keep it current afterwards
+	void RebuildGraphIndex();
+	// Creates the worker the registration/rename/connect callbacks hand their events to
+	void StartGraphEventWorker();
+	// Body of ApplyRoutingMatrix; control thread only
+	FJackRoutingResult ApplyRoutingMatrixNow(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope) const;
+#endif
 
 	jack_client_t* JackClient = nullptr;
-	TArray<jack_port_t*> InputPorts;
-	TArray<jack_port_t*> OutputPorts;
-	TSet<FString> KnownClientsLogged;
+	// Clients, ports and connections of the whole JACK graph, kept by the notification callbacks through
+	// GraphEventWorker (which lives from Connect to Disconnect)
+	FJackGraphIndex GraphIndex;
+	TUniquePtr<FJackGraphEventWorker> GraphEventWorker;
+	// Runs routing work off the game thread; also lives from Connect to Disconnect
+	TUniquePtr<FJackControlThread> ControlThread;
+
+#if WITH_JACK
+	// Port set publication. ActivePortSet is replaced on the game thread and read elsewhere under PortSetLock;
+	// the process callback reads RTPortSet and pins the set it is using in RTPortSetInUse (a hazard pointer),
+	// so a replaced set is only freed, and its removed ports unregistered, once the callback has let go of it.
+	struct FRetiredPortSet
+	{
+		FJackPortSetPtr PortSet;
+		TArray<jack_port_t*> PortsToUnregister;
+	};
+	void PublishPortSet(FJackPortSetPtr NewPortSet, TArray<jack_port_t*> PortsToUnregister);
+	bool ReclaimRetiredPortSets(); // Returns true while some sets are still pinned
+	// Re-reads the connection state of our ports in PortSet that match PortA/PortB (all ports when both are null)
+	void UpdatePortConnections(const FJackPortSet& PortSet, const jack_port_t* PortA = nullptr, const jack_port_t* PortB = nullptr) const;
+
+	FJackPortSetPtr ActivePortSet;
+	mutable FCriticalSection PortSetLock;
+	// Bumped each time ActivePortSet is replaced
+	std::atomic<uint32> PortSetGeneration{0};
+	std::atomic<const FJackPortSet*> RTPortSet{nullptr};
+	std::atomic<const FJackPortSet*> RTPortSetInUse{nullptr};
+	// Process hook, pinned by the callback the same way as the port set
+	std::atomic<IJackProcessHook*> ProcessHook{nullptr};
+	std::atomic<IJackProcessHook*> ProcessHookInUse{nullptr};
+	TArray<FRetiredPortSet> RetiredPortSets;
+	FTSTicker::FDelegateHandle RetireTickHandle;
+
+	// Ring buffering (input + output, frames) last reported to JACK through the latency callback
+	std::atomic<int32> ReportedRingLatency{0};
+	FTSTicker::FDelegateHandle LatencyTickHandle;
+#endif
+
+	// False (with a warning) when game-thread I/O on Channels would share a ring with a claimed channel
+	bool CheckUnclaimed(bool bInput, TConstArrayView<int32> Channels, bool bSharedRing) const;
+	// Owner of each channel by index, null when free (see ClaimChannels)
+	TArray<const void*> InputChannelOwners;
+	TArray<const void*> OutputChannelOwners;
+	mutable FCriticalSection ChannelOwnerLock;
+
+	// Game-side ring rates for SetSampleRateConversion (0 = JACK rate); game thread only
+	uint32 InputRingSampleRate = 0;
+	uint32 OutputRingSampleRate = 0;
+
+	// Smoothing parameters for the input meters, read by the process callback every cycle
+	std::atomic<float> MeterIntegrationWindowSeconds{0.3f};
+	std::atomic<float> MeterPeakDecayDbPerSecond{20.0f};
+
+	std::atomic<uint64> AudioBufferAllocations{0};
+	std::atomic<int32> LastCycleActivePorts{0};
+	std::atomic<int32> LastCycleRegisteredPorts{0};
+	FJackCallbackTimingHistogram CallbackTiming;
 
-	// Audio ring buffers for thread-safe I/O
-	TArray<TUniquePtr<FAudioRingBuffer>> InputRingBuffers;
-	TArray<TUniquePtr<FAudioRingBuffer>> OutputRingBuffers;
+	// Published by the process callback for xrun reports
+	std::atomic<int32> LastCycleInputRingFill{0};
+	std::atomic<int32> LastCycleOutputRingFill{0};
+	std::atomic<uint64> XrunCount{0};
+	TCircularQueue<FJackXrunEvent> XrunEvents{64};
 };
\ No newline at end of file
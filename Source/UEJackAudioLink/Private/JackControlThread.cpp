@@ -0,0 +1,57 @@
+#include "JackControlThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FJackControlThread::FJackControlThread()
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("JackControl"), 0, TPri_Normal);
+}
+
+FJackControlThread::~FJackControlThread()
+{
+	if (Thread)
+	{
+		// Kill(true) calls Stop and waits for Run to return
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	// Anything queued after the thread exited still gets to run
+	RunQueuedTasks();
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FJackControlThread::Enqueue(TUniqueFunction<void()>&& Task)
+{
+	Tasks.Enqueue(MoveTemp(Task));
+	WakeEvent->Trigger();
+}
+
+void FJackControlThread::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+uint32 FJackControlThread::Run()
+{
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		WakeEvent->Wait();
+		RunQueuedTasks();
+	}
+	RunQueuedTasks();
+	return 0;
+}
+
+void FJackControlThread::RunQueuedTasks()
+{
+	TUniqueFunction<void()> Task;
+	while (Tasks.Dequeue(Task))
+	{
+		Task();
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "Async/Future.h"
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+// Dedicated thread for JACK control calls (connect, disconnect, graph queries) so their server round-trips
+// never land on the game thread. Tasks run one at a time in submission order; any thread may submit.
+// Stopping runs what is still queued first, so every returned future is fulfilled.
+class FJackControlThread : public FRunnable
+{
+public:
+	FJackControlThread();
+	virtual ~FJackControlThread() override;
+
+	void Enqueue(TUniqueFunction<void()>&& Task);
+
+	template<typename ResultType>
+	TFuture<ResultType> Submit(TUniqueFunction<ResultType()>&& Task)
+	{
+		TSharedRef<TPromise<ResultType>> Promise = MakeShared<TPromise<ResultType>>();
+		TFuture<ResultType> Future = Promise->GetFuture();
+		Enqueue([Promise, Task = MoveTemp(Task)]() mutable
+		{
+			Promise->SetValue(Task());
+		});
+		return Future;
+	}
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void RunQueuedTasks();
+
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Tasks;
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{false};
+};
@@ -0,0 +1,139 @@
+#include "JackDriftCompensation.h"
+#include "Math/VectorRegister.h"
+
+void FJackDriftEstimator::Configure(double InBandwidthHz, double InMaxCorrectionPpm)
+{
+	BandwidthHz = FMath::Max(InBandwidthHz, 0.0);
+	MaxCorrection = FMath::Max(InMaxCorrectionPpm, 0.0) * 1.0e-6;
+	Reset();
+}
+
+void FJackDriftEstimator::Reset()
+{
+	SmoothedError = 0.0;
+	Integral = 0.0;
+	Correction = 0.0;
+	bPrimed = false;
+}
+
+double FJackDriftEstimator::Update(int32 FillFrames, int32 TargetFillFrames, int32 BlockFrames, double BlockSeconds)
+{
+	if (BlockFrames <= 0 || BlockSeconds <= 0.0)
+	{
+		return 1.0 + Correction;
+	}
+	// Per block the fill moves by (correction - drift) * BlockFrames, so measuring the error in blocks makes the
+	// plant a plain integrator and the critically damped DLL coefficients apply directly.
+	const double Omega = 2.0 * PI * BandwidthHz * BlockSeconds;
+	const double Error = static_cast<double>(FillFrames - TargetFillFrames) / BlockFrames;
+	// The fill seen at a block boundary jumps by up to a JACK period depending on where the server's cycle
+	// fell; average that out well above the loop bandwidth so the ratio does not follow it
+	const double Smoothing = 1.0 - FMath::Exp(-2.0 * Omega);
+	SmoothedError = bPrimed ? SmoothedError + Smoothing * (Error - SmoothedError) : Error;
+	bPrimed = true;
+	Integral = FMath::Clamp(Integral + Omega * Omega * SmoothedError, -MaxCorrection, MaxCorrection);
+	Correction = FMath::Clamp(UE_SQRT_2 * Omega * SmoothedError + Integral, -MaxCorrection, MaxCorrection);
+	return 1.0 + Correction;
+}
+
+void FJackVariableResampler::Init(int32 InNumChannels, int32 MaxInputFrames)
+{
+	NumChannels = FMath::Max(InNumChannels, 1);
+	MaxInput = FMath::Max(MaxInputFrames, 1);
+	// Room for one full input block on top of the taps kept between calls
+	Pending.SetNumZeroed((MaxInput + 8) * NumChannels);
+	Reset();
+}
+
+void FJackVariableResampler::Reset()
+{
+	// Two frames of silence so the first output has its left-hand taps
+	NumPending = 2;
+	Position = 1.0;
+	FMemory::Memzero(Pending.GetData(), Pending.Num() * sizeof(float));
+}
+
+int32 FJackVariableResampler::GetInputFramesNeeded(int32 NumOutputFrames, double Ratio) const
+{
+	if (NumOutputFrames <= 0)
+	{
+		return 0;
+	}
+	// The last output reads frames floor(P)-1 .. floor(P)+2
+	const double LastPosition = Position + (NumOutputFrames - 1) * Ratio;
+	return FMath::Max(static_cast<int32>(FMath::FloorToDouble(LastPosition)) + 3 - NumPending, 0);
+}
+
+void FJackVariableResampler::InterpolateFrame(const float* Taps, float Fraction, float* Out) const
+{
+	// Catmull-Rom weights of the four taps around the read position
+	const float F2 = Fraction * Fraction;
+	const float F3 = F2 * Fraction;
+	const float W0 = -0.5f * F3 + F2 - 0.5f * Fraction;
+	const float W1 = 1.5f * F3 - 2.5f * F2 + 1.0f;
+	const float W2 = -1.5f * F3 + 2.0f * F2 + 0.5f * Fraction;
+	const float W3 = 0.5f * F3 - 0.5f * F2;
+
+	const float* T0 = Taps;
+	const float* T1 = Taps + NumChannels;
+	const float* T2 = Taps + 2 * NumChannels;
+	const float* T3 = Taps + 3 * NumChannels;
+	int32 Ch = 0;
+	if (NumChannels >= 4)
+	{
+		const VectorRegister4Float V0 = VectorSetFloat1(W0);
+		const VectorRegister4Float V1 = VectorSetFloat1(W1);
+		const VectorRegister4Float V2 = VectorSetFloat1(W2);
+		const VectorRegister4Float V3 = VectorSetFloat1(W3);
+		for (; Ch + 4 <= NumChannels; Ch += 4)
+		{
+			VectorRegister4Float Sum = VectorMultiply(VectorLoad(T0 + Ch), V0);
+			Sum = VectorMultiplyAdd(VectorLoad(T1 + Ch), V1, Sum);
+			Sum = VectorMultiplyAdd(VectorLoad(T2 + Ch), V2, Sum);
+			Sum = VectorMultiplyAdd(VectorLoad(T3 + Ch), V3, Sum);
+			VectorStore(Sum, Out + Ch);
+		}
+	}
+	for (; Ch < NumChannels; ++Ch)
+	{
+		Out[Ch] = W0 * T0[Ch] + W1 * T1[Ch] + W2 * T2[Ch] + W3 * T3[Ch];
+	}
+}
+
+int32 FJackVariableResampler::Process(const float* Input, int32 NumInputFrames, float* Output, int32 MaxOutputFrames, double Ratio)
+{
+	if (NumChannels == 0)
+	{
+		return 0;
+	}
+	const int32 Capacity = Pending.Num() / NumChannels;
+	const int32 NumToAppend = FMath::Clamp(NumInputFrames, 0, Capacity - NumPending);
+	if (Input && NumToAppend > 0)
+	{
+		FMemory::Memcpy(Pending.GetData() + NumPending * NumChannels, Input, NumToAppend * NumChannels * sizeof(float));
+		NumPending += NumToAppend;
+	}
+
+	int32 NumOutput = 0;
+	while (NumOutput < MaxOutputFrames)
+	{
+		const int32 Index = static_cast<int32>(Position);
+		if (Index + 2 >= NumPending)
+		{
+			break;
+		}
+		InterpolateFrame(Pending.GetData() + (Index - 1) * NumChannels, static_cast<float>(Position - Index), Output + NumOutput * NumChannels);
+		Position += Ratio;
+		++NumOutput;
+	}
+
+	// Drop the frames no future output can reach (everything left of the next left-hand tap)
+	const int32 NumConsumed = FMath::Clamp(static_cast<int32>(Position) - 1, 0, NumPending);
+	if (NumConsumed > 0)
+	{
+		NumPending -= NumConsumed;
+		FMemory::Memmove(Pending.GetData(), Pending.GetData() + NumConsumed * NumChannels, NumPending * NumChannels * sizeof(float));
+		Position -= NumConsumed;
+	}
+	return NumOutput;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Clock-drift compensation across a ring whose two ends run on different clocks (UE's audio device on one
+// side, the JACK server on the other). The fill level of the ring integrates the rate mismatch, so a DLL on
+// it yields the conversion ratio; a variable-ratio resampler on the UE side of the ring then applies it.
+// Latency stays at the target fill instead of creeping until the ring over- or underflows.
+
+// Second-order loop (PI) on the ring fill level, updated once per UE block. The ratio it returns is input
+// frames per output frame of the resampler; above 1 drains the ring, below 1 fills it.
+class FJackDriftEstimator
+{
+public:
+	// BandwidthHz sets how fast the loop follows; keep it far below the block rate so the scheduling jitter
+	// of either side is averaged out. MaxCorrectionPpm bounds the deviation from the nominal ratio.
+	void Configure(double InBandwidthHz, double InMaxCorrectionPpm);
+	void Reset();
+
+	// FillFrames: ring fill sampled at the same point of every block; BlockSeconds: duration of that block
+	double Update(int32 FillFrames, int32 TargetFillFrames, int32 BlockFrames, double BlockSeconds);
+
+	// Current correction, in parts per million, as last returned by Update
+	double GetCorrectionPpm() const { return Correction * 1.0e6; }
+
+private:
+	double BandwidthHz = 0.02;
+	double MaxCorrection = 1.0e-3;
+	double SmoothedError = 0.0;
+	double Integral = 0.0;
+	double Correction = 0.0;
+	bool bPrimed = false;
+};
+
+// Streaming cubic (Catmull-Rom) resampler for interleaved frames at a ratio that may change every block.
+// SIMD runs across channels, four at a time, so the interleaved layout is used as is. Input that has not
+// been interpolated past yet is kept between calls; nothing allocates after Init.
+class FJackVariableResampler
+{
+public:
+	// MaxInputFrames bounds the input of one Process call
+	void Init(int32 InNumChannels, int32 MaxInputFrames);
+	void Reset();
+
+	int32 GetNumChannels() const { return NumChannels; }
+	int32 GetMaxInputFrames() const { return MaxInput; }
+
+	// Input frames Process needs to produce exactly NumOutputFrames at Ratio (input frames per output frame)
+	int32 GetInputFramesNeeded(int32 NumOutputFrames, double Ratio) const;
+
+	// Consumes all NumInputFrames frames (clamped to MaxInputFrames) and writes up to MaxOutputFrames
+	// interpolated frames to Output; returns the number written
+	int32 Process(const float* Input, int32 NumInputFrames, float* Output, int32 MaxOutputFrames, double Ratio);
+
+private:
+	void InterpolateFrame(const float* Taps, float Fraction, float* Out) const;
+
+	int32 NumChannels = 0;
+	int32 MaxInput = 0;
+	// Pending input frames, interleaved; Position is the fractional read position within them
+	TArray<float> Pending;
+	int32 NumPending = 0;
+	double Position = 0.0;
+};
@@ -0,0 +1,129 @@
+#include "JackGraphEventWorker.h"
+#include "JackGraphIndex.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+FJackGraphEventWorker::FJackGraphEventWorker(FJackGraphIndex& InIndex, FClientAppearedFunc InOnClientAppeared, FClientGoneFunc InOnClientGone)
+	: Index(InIndex)
+	, OnClientAppeared(MoveTemp(InOnClientAppeared))
+	, OnClientGone(MoveTemp(InOnClientGone))
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("JackGraphEvents"), 0, TPri_BelowNormal);
+}
+
+FJackGraphEventWorker::~FJackGraphEventWorker()
+{
+	if (Thread)
+	{
+		// Kill(true) calls Stop and waits for Run to return
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FJackGraphEventWorker::Enqueue(FJackGraphEvent&& Event)
+{
+	Events.Enqueue(MoveTemp(Event));
+	WakeEvent->Trigger();
+}
+
+void FJackGraphEventWorker::Stop()
+{
+	bStopping.store(true, std::memory_order_relaxed);
+	WakeEvent->Trigger();
+}
+
+uint32 FJackGraphEventWorker::Run()
+{
+	double WaitSeconds = -1.0;
+	while (!bStopping.load(std::memory_order_relaxed))
+	{
+		// Sleep until an event arrives or the earliest pending window closes
+		WakeEvent->Wait(WaitSeconds < 0.0 ? MAX_uint32 : static_cast<uint32>(FMath::CeilToInt(WaitSeconds * 1000.0)));
+		if (bStopping.load(std::memory_order_relaxed))
+		{
+			break;
+		}
+		const double Now = FPlatformTime::Seconds();
+		DrainEvents(Now);
+		WaitSeconds = AnnounceSettledClients(Now);
+	}
+	return 0;
+}
+
+void FJackGraphEventWorker::DrainEvents(double NowSeconds)
+{
+	FJackGraphEvent Event;
+	while (Events.Dequeue(Event))
+	{
+		switch (Event.Type)
+		{
+		case FJackGraphEvent::EType::PortRegistered:
+			if (Index.AddPort(Event.Name, Event.bInput, Event.bAudio))
+			{
+				PendingClients.Add(Event.ClientName, FPendingClient{NowSeconds, NowSeconds});
+			}
+			else if (FPendingClient* Pending = PendingClients.Find(Event.ClientName))
+			{
+				Pending->LastSeconds = NowSeconds;
+			}
+			break;
+		case FJackGraphEvent::EType::PortUnregistered:
+			if (Index.RemovePort(Event.Name))
+			{
+				OnClientRemoved(Event.ClientName);
+			}
+			break;
+		case FJackGraphEvent::EType::PortRenamed:
+			Index.RenamePort(Event.Name, Event.OtherName);
+			break;
+		case FJackGraphEvent::EType::PortsConnected:
+		case FJackGraphEvent::EType::PortsDisconnected:
+			Index.SetConnected(Event.Name, Event.OtherName, Event.Type == FJackGraphEvent::EType::PortsConnected);
+			break;
+		case FJackGraphEvent::EType::ClientUnregistered:
+			// Normally its ports went first and the client is already gone from the index
+			if (Index.HasClient(Event.ClientName))
+			{
+				Index.RemoveClient(Event.ClientName);
+				OnClientRemoved(Event.ClientName);
+			}
+			break;
+		}
+	}
+}
+
+void FJackGraphEventWorker::OnClientRemoved(const FString& ClientName)
+{
+	// Gone before it was announced: nobody heard of it
+	if (PendingClients.Remove(ClientName) == 0 && OnClientGone)
+	{
+		OnClientGone(ClientName);
+	}
+}
+
+double FJackGraphEventWorker::AnnounceSettledClients(double NowSeconds)
+{
+	double NextSeconds = -1.0;
+	for (auto It = PendingClients.CreateIterator(); It; ++It)
+	{
+		const double Deadline = FMath::Min(It->Value.LastSeconds + DebounceSeconds, It->Value.FirstSeconds + MaxDelaySeconds);
+		if (Deadline > NowSeconds)
+		{
+			NextSeconds = NextSeconds < 0.0 ? Deadline - NowSeconds : FMath::Min(NextSeconds, Deadline - NowSeconds);
+			continue;
+		}
+		const FString ClientName = It->Key;
+		It.RemoveCurrent();
+		if (OnClientAppeared)
+		{
+			OnClientAppeared(ClientName, Index.GetNumClientPorts(ClientName, true), Index.GetNumClientPorts(ClientName, false));
+		}
+	}
+	return NextSeconds;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class FJackGraphIndex;
+class FRunnableThread;
+class FEvent;
+
+// A graph change as reported by one of JACK's notification callbacks, with names already resolved
+struct FJackGraphEvent
+{
+	enum class EType : uint8
+	{
+		PortRegistered,
+		PortUnregistered,
+		PortRenamed,        // Name -> OtherName
+		PortsConnected,     // Name <-> OtherName
+		PortsDisconnected,
+		ClientUnregistered, // ClientName only
+	};
+	EType Type = EType::PortRegistered;
+	FString ClientName;
+	FString Name;
+	FString OtherName;
+	bool bInput = false;
+	bool bAudio = false;
+};
+
+// Takes graph changes off JACK's notification thread. The callbacks only enqueue (lock-free, multi-producer);
+// a worker thread applies the events to the graph index in order and coalesces the port storm of a client
+// that appears (a 64-channel client is 64+ events) into one announcement, made once no port of that client
+// has arrived for DebounceSeconds (or MaxDelaySeconds after its first port), with its final port counts.
+// A client that appears and vanishes within the window is never announced.
+class FJackGraphEventWorker : public FRunnable
+{
+public:
+	// Both run on the worker thread
+	using FClientAppearedFunc = TFunction<void(const FString& ClientName, int32 NumInputs, int32 NumOutputs)>;
+	using FClientGoneFunc = TFunction<void(const FString& ClientName)>;
+
+	static constexpr double DebounceSeconds = 0.1;
+	static constexpr double MaxDelaySeconds = 1.0;
+
+	FJackGraphEventWorker(FJackGraphIndex& InIndex, FClientAppearedFunc InOnClientAppeared, FClientGoneFunc InOnClientGone);
+	virtual ~FJackGraphEventWorker() override;
+
+	// Any thread; never blocks
+	void Enqueue(FJackGraphEvent&& Event);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FPendingClient
+	{
+		double FirstSeconds = 0.0;
+		double LastSeconds = 0.0;
+	};
+
+	void DrainEvents(double NowSeconds);
+	// Announces the clients whose window has closed; returns seconds until the next window closes (negative when none is pending)
+	double AnnounceSettledClients(double NowSeconds);
+	void OnClientRemoved(const FString& ClientName);
+
+	FJackGraphIndex& Index;
+	FClientAppearedFunc OnClientAppeared;
+	FClientGoneFunc OnClientGone;
+
+	TQueue<FJackGraphEvent, EQueueMode::Mpsc> Events;
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{false};
+
+	// Worker thread only
+	TMap<FString, FPendingClient> PendingClients;
+};
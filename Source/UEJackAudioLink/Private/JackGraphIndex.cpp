@@ -0,0 +1,286 @@
+#include "JackGraphIndex.h"
+
+static FString GetPortClient(const FString& PortName)
+{
+	FString Client;
+	PortName.Split(TEXT(":"), &Client, nullptr);
+	return Client;
+}
+
+void FJackGraphIndex::Rebuild(TFunctionRef<void(TArray<FJackGraphPortInfo>&)> Gather)
+{
+	FWriteScopeLock WriteLock(Lock);
+	Ports.Reset();
+	Clients.Reset();
+	ClientOrder.Reset();
+
+	TArray<FJackGraphPortInfo> Infos;
+	Gather(Infos);
+	for (const FJackGraphPortInfo& Info : Infos)
+	{
+		AddPortLocked(Info.Name, Info.bInput, Info.bAudio);
+	}
+	// A connection may be listed from one end or both; it is recorded on both either way
+	for (const FJackGraphPortInfo& Info : Infos)
+	{
+		for (const FString& Other : Info.Connections)
+		{
+			SetConnectedLocked(Info.Name, Other, true);
+		}
+	}
+}
+
+void FJackGraphIndex::Reset()
+{
+	FWriteScopeLock WriteLock(Lock);
+	Ports.Reset();
+	Clients.Reset();
+	ClientOrder.Reset();
+}
+
+bool FJackGraphIndex::AddPort(const FString& PortName, bool bInput, bool bAudio)
+{
+	FWriteScopeLock WriteLock(Lock);
+	return AddPortLocked(PortName, bInput, bAudio);
+}
+
+bool FJackGraphIndex::AddPortLocked(const FString& PortName, bool bInput, bool bAudio)
+{
+	const FString ClientName = GetPortClient(PortName);
+	if (ClientName.IsEmpty() || Ports.Contains(PortName))
+	{
+		return false;
+	}
+	FPort& Port = Ports.Add(PortName);
+	Port.Client = ClientName;
+	Port.bInput = bInput;
+	Port.bAudio = bAudio;
+
+	FClient* Client = Clients.Find(ClientName);
+	const bool bNewClient = Client == nullptr;
+	if (bNewClient)
+	{
+		Client = &Clients.Add(ClientName);
+		ClientOrder.Add(ClientName);
+	}
+	++Client->NumPorts;
+	if (bAudio)
+	{
+		(bInput ? Client->InputPorts : Client->OutputPorts).Add(PortName);
+	}
+	return bNewClient;
+}
+
+bool FJackGraphIndex::RemovePort(const FString& PortName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	return RemovePortLocked(PortName);
+}
+
+bool FJackGraphIndex::RemovePortLocked(const FString& PortName)
+{
+	FPort Port;
+	if (!Ports.RemoveAndCopyValue(PortName, Port))
+	{
+		return false;
+	}
+	for (const FString& Other : Port.Connections)
+	{
+		if (FPort* OtherPort = Ports.Find(Other))
+		{
+			OtherPort->Connections.Remove(PortName);
+		}
+	}
+
+	FClient* Client = Clients.Find(Port.Client);
+	if (!Client)
+	{
+		return false;
+	}
+	if (Port.bAudio)
+	{
+		(Port.bInput ? Client->InputPorts : Client->OutputPorts).Remove(PortName);
+	}
+	if (--Client->NumPorts > 0)
+	{
+		return false;
+	}
+	Clients.Remove(Port.Client);
+	ClientOrder.Remove(Port.Client);
+	return true;
+}
+
+void FJackGraphIndex::RenamePort(const FString& OldName, const FString& NewName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	FPort Port;
+	if (OldName == NewName || !Ports.RemoveAndCopyValue(OldName, Port))
+	{
+		return;
+	}
+	for (const FString& Other : Port.Connections)
+	{
+		if (FPort* OtherPort = Ports.Find(Other))
+		{
+			OtherPort->Connections.Remove(OldName);
+			OtherPort->Connections.Add(NewName);
+		}
+	}
+
+	// A rename keeps the port's position within its client
+	const FString NewClient = GetPortClient(NewName);
+	FClient* Client = Clients.Find(Port.Client);
+	if (Client && NewClient == Port.Client)
+	{
+		if (Port.bAudio)
+		{
+			TArray<FString>& List = Port.bInput ? Client->InputPorts : Client->OutputPorts;
+			const int32 Position = List.IndexOfByKey(OldName);
+			if (Position != INDEX_NONE)
+			{
+				List[Position] = NewName;
+			}
+		}
+		Ports.Add(NewName, MoveTemp(Port));
+		return;
+	}
+
+	// Moved to another client name: drop it from the old client (the peers already point at the new
+	// name, so it goes back in without connections) and add it to the new one
+	const bool bInput = Port.bInput;
+	const bool bAudio = Port.bAudio;
+	const TArray<FString> Connections = MoveTemp(Port.Connections);
+	Port.Connections.Reset();
+	Ports.Add(OldName, MoveTemp(Port));
+	RemovePortLocked(OldName);
+	AddPortLocked(NewName, bInput, bAudio);
+	for (const FString& Other : Connections)
+	{
+		SetConnectedLocked(NewName, Other, true);
+	}
+}
+
+void FJackGraphIndex::RemoveClient(const FString& ClientName)
+{
+	FWriteScopeLock WriteLock(Lock);
+	TArray<FString> ClientPorts;
+	for (const TPair<FString, FPort>& Pair : Ports)
+	{
+		if (Pair.Value.Client == ClientName)
+		{
+			ClientPorts.Add(Pair.Key);
+		}
+	}
+	for (const FString& PortName : ClientPorts)
+	{
+		RemovePortLocked(PortName);
+	}
+	Clients.Remove(ClientName);
+	ClientOrder.Remove(ClientName);
+}
+
+void FJackGraphIndex::SetConnected(const FString& PortA, const FString& PortB, bool bConnected)
+{
+	FWriteScopeLock WriteLock(Lock);
+	SetConnectedLocked(PortA, PortB, bConnected);
+}
+
+void FJackGraphIndex::SetConnectedLocked(const FString& PortA, const FString& PortB, bool bConnected)
+{
+	FPort* A = Ports.Find(PortA);
+	FPort* B = Ports.Find(PortB);
+	if (!A || !B)
+	{
+		return;
+	}
+	if (bConnected)
+	{
+		A->Connections.AddUnique(PortB);
+		B->Connections.AddUnique(PortA);
+	}
+	else
+	{
+		A->Connections.Remove(PortB);
+		B->Connections.Remove(PortA);
+	}
+}
+
+TArray<FString> FJackGraphIndex::GetClients() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return ClientOrder;
+}
+
+bool FJackGraphIndex::HasClient(const FString& ClientName) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return Clients.Contains(ClientName);
+}
+
+TArray<FString> FJackGraphIndex::GetClientPorts(const FString& ClientName, bool bInput) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FClient* Client = Clients.Find(ClientName))
+	{
+		return bInput ? Client->InputPorts : Client->OutputPorts;
+	}
+	return TArray<FString>();
+}
+
+int32 FJackGraphIndex::GetNumClientPorts(const FString& ClientName, bool bInput) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FClient* Client = Clients.Find(ClientName))
+	{
+		return bInput ? Client->InputPorts.Num() : Client->OutputPorts.Num();
+	}
+	return 0;
+}
+
+FString FJackGraphIndex::GetClientPort(const FString& ClientName, bool bInput, int32 PortIndex) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FClient* Client = Clients.Find(ClientName))
+	{
+		const TArray<FString>& List = bInput ? Client->InputPorts : Client->OutputPorts;
+		if (List.IsValidIndex(PortIndex))
+		{
+			return List[PortIndex];
+		}
+	}
+	return FString();
+}
+
+TArray<FString> FJackGraphIndex::GetConnections(const FString& PortName) const
+{
+	FReadScopeLock ReadLock(Lock);
+	if (const FPort* Port = Ports.Find(PortName))
+	{
+		return Port->Connections;
+	}
+	return TArray<FString>();
+}
+
+TArray<TPair<FString, FString>> FJackGraphIndex::GetAudioConnections() const
+{
+	FReadScopeLock ReadLock(Lock);
+	TArray<TPair<FString, FString>> Connections;
+	for (const FString& ClientName : ClientOrder)
+	{
+		for (const FString& PortName : Clients.FindChecked(ClientName).OutputPorts)
+		{
+			for (const FString& Other : Ports.FindChecked(PortName).Connections)
+			{
+				Connections.Emplace(PortName, Other);
+			}
+		}
+	}
+	return Connections;
+}
+
+bool FJackGraphIndex::IsConnected(const FString& SourcePort, const FString& DestinationPort) const
+{
+	FReadScopeLock ReadLock(Lock);
+	const FPort* Port = Ports.Find(SourcePort);
+	return Port && Port->Connections.Contains(DestinationPort);
+}
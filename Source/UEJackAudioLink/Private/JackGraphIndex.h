@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+// One port as seen while (re)building the graph index
+struct FJackGraphPortInfo
+{
+	FString Name;          // Full name, "client:port"
+	bool bInput = false;   // JackPortIsInput
+	bool bAudio = false;   // JACK_DEFAULT_AUDIO_TYPE
+	TArray<FString> Connections;
+};
+
+// Local copy of the JACK graph: clients -> ports in registration order -> connections. Built once when the
+// client activates and then kept current from the registration, rename and connect callbacks, so discovery
+// queries are map lookups instead of jack_get_ports round-trips. Knows nothing about JACK itself.
+// Updates come from JACK's notification thread, queries from anywhere; readers share an FRWLock.
+class FJackGraphIndex
+{
+public:
+	// Replaces the whole index with the ports Gather reports. Gather runs under the write lock, so callback
+	// updates that race with it are applied after the snapshot rather than lost or overwritten.
+	void Rebuild(TFunctionRef<void(TArray<FJackGraphPortInfo>&)> Gather);
+	void Reset();
+
+	// Returns true when the port is the first of its client (the client just appeared)
+	bool AddPort(const FString& PortName, bool bInput, bool bAudio);
+	// Returns true when the port was the last of its client (the client is gone)
+	bool RemovePort(const FString& PortName);
+	void RenamePort(const FString& OldName, const FString& NewName);
+	void RemoveClient(const FString& ClientName);
+	void SetConnected(const FString& PortA, const FString& PortB, bool bConnected);
+
+	// Clients with at least one port, in the order they appeared
+	TArray<FString> GetClients() const;
+	bool HasClient(const FString& ClientName) const;
+	// Audio ports of a client, in registration order
+	TArray<FString> GetClientPorts(const FString& ClientName, bool bInput) const;
+	int32 GetNumClientPorts(const FString& ClientName, bool bInput) const;
+	// Port at a 0-based position of GetClientPorts; empty when out of range
+	FString GetClientPort(const FString& ClientName, bool bInput, int32 PortIndex) const;
+	TArray<FString> GetConnections(const FString& PortName) const;
+	bool IsConnected(const FString& SourcePort, const FString& DestinationPort) const;
+	// Every connection from an audio output, as (output, input), by client then port order
+	TArray<TPair<FString, FString>> GetAudioConnections() const;
+
+private:
+	struct FPort
+	{
+		FString Client;
+		bool bInput = false;
+		bool bAudio = false;
+		TArray<FString> Connections;
+	};
+	struct FClient
+	{
+		TArray<FString> InputPorts;   // Audio only
+		TArray<FString> OutputPorts;
+		int32 NumPorts = 0;           // Any type
+	};
+
+	// Callers hold the write lock
+	bool AddPortLocked(const FString& PortName, bool bInput, bool bAudio);
+	bool RemovePortLocked(const FString& PortName);
+	void SetConnectedLocked(const FString& PortA, const FString& PortB, bool bConnected);
+
+	mutable FRWLock Lock;
+	TMap<FString, FPort> Ports;
+	TMap<FString, FClient> Clients;
+	TArray<FString> ClientOrder;
+};
@@ -0,0 +1,142 @@
+#include "JackInputSynthComponent.h"
+#include "JackAudioLinkSettings.h"
+#include "JackClientManager.h"
+#include "JackDriftCompensation.h"
+#include "UEJackAudioLinkLog.h"
+
+// Largest render block read through the resampler; bigger ones are read straight from the rings
+static constexpr int32 JackInputMaxBlockFrames = 4096;
+
+struct FJackInputDriftState
+{
+	FJackDriftEstimator Estimator;
+	FJackVariableResampler Resampler;
+	TArray<float> InputFrames;
+};
+
+UJackInputSynthComponent::UJackInputSynthComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+bool UJackInputSynthComponent::Init(int32& SampleRate)
+{
+	RenderChannels = InputChannels;
+	if (RenderChannels.Num() == 0)
+	{
+		RenderChannels.Add(0);
+	}
+	if (RenderChannels.Num() > 8)
+	{
+		UE_LOG(LogJackAudioLink, Warning, TEXT("%s: %d input channels requested, playing the first 8"), *GetName(), RenderChannels.Num());
+		RenderChannels.SetNum(8);
+	}
+	NumChannels = RenderChannels.Num();
+
+	// The rings take one consumer: from here on this component reads these inputs and game-thread reads are refused
+	FJackClientManager& Client = FJackClientManager::Get();
+	Client.ReleaseChannels(true, this);
+	if (!Client.ClaimChannels(true, RenderChannels, this))
+	{
+		return false;
+	}
+
+	// The source runs at the rate of the input rings (the JACK rate unless converted) and the mixer converts,
+	// so JACK audio is never pitched
+	const uint32 RingSampleRate = Client.GetRingSampleRate(true);
+	if (RingSampleRate > 0)
+	{
+		SampleRate = static_cast<int32>(RingSampleRate);
+	}
+	RenderSampleRate = SampleRate;
+
+	// The mixer's conversion is fixed-ratio, so the remaining drift is taken up here
+	DriftState.Reset();
+	DriftCorrectionPpm.store(0.0f, std::memory_order_relaxed);
+	const UJackAudioLinkSettings* Settings = GetDefault<UJackAudioLinkSettings>();
+	if (Settings && Settings->bCompensateClockDrift)
+	{
+		// A little over a block of input, since the loop may consume faster than it renders
+		const int32 MaxInputFrames = JackInputMaxBlockFrames + JackInputMaxBlockFrames / 64;
+		DriftState = MakeShared<FJackInputDriftState>();
+		DriftState->Estimator.Configure(Settings->DriftLoopBandwidthHz, Settings->MaxDriftCorrectionPpm);
+		DriftState->Resampler.Init(NumChannels, MaxInputFrames);
+		DriftState->InputFrames.SetNumZeroed(MaxInputFrames * NumChannels);
+	}
+	bTrimBacklog.store(true, std::memory_order_relaxed);
+	return true;
+}
+
+void UJackInputSynthComponent::OnEndGenerate()
+{
+	FJackClientManager::Get().ReleaseChannels(true, this);
+}
+
+void UJackInputSynthComponent::OnUnregister()
+{
+	FJackClientManager::Get().ReleaseChannels(true, this);
+	Super::OnUnregister();
+}
+
+int32 UJackInputSynthComponent::OnGenerateAudio(float* OutAudio, int32 NumSamples)
+{
+#if WITH_JACK
+	const int32 NumFrames = NumSamples / FMath::Max(NumChannels, 1);
+	// Keep the port set across blocks; fetching it takes PortSetLock, so only do that when it was replaced
+	FJackClientManager& Client = FJackClientManager::Get();
+	const uint32 Generation = Client.GetPortSetGeneration();
+	if (Generation != PortSetGeneration)
+	{
+		PortSet = Client.GetPortSet();
+		PortSetGeneration = Generation;
+	}
+	if (!PortSet)
+	{
+		FMemory::Memzero(OutAudio, NumSamples * sizeof(float));
+		return NumSamples;
+	}
+	const FJackPortSet& Set = *PortSet;
+	FJackInputDriftState* Drift = NumFrames <= JackInputMaxBlockFrames ? DriftState.Get() : nullptr;
+
+	// With drift compensation the loop holds one render block plus one JACK period buffered; start there
+	const int32 TargetFill = NumFrames + Client.GetRingPeriodFrames(Set, true);
+	if (bTrimBacklog.exchange(false, std::memory_order_relaxed))
+	{
+		FJackClientManager::TrimInputBacklog(Set, RenderChannels, Drift ? FMath::Max(MaxStartupBacklogFrames, TargetFill) : MaxStartupBacklogFrames);
+		if (Drift)
+		{
+			Drift->Estimator.Reset();
+			Drift->Resampler.Reset();
+		}
+	}
+
+	if (!Drift)
+	{
+		// Missing frames come back as silence; always hand the mixer a full buffer so the source keeps playing
+		if (FJackClientManager::ReadAudioFrames(Set, RenderChannels, NumFrames, true, TArrayView<float>(OutAudio, NumSamples)) == 0)
+		{
+			FMemory::Memzero(OutAudio, NumSamples * sizeof(float));
+		}
+		return NumSamples;
+	}
+
+	// Fill is sampled before this block is taken out, so it reads the same point of the cycle every time
+	const double Ratio = Drift->Estimator.Update(FJackClientManager::GetBufferedFrames(Set, true, RenderChannels[0]), TargetFill, NumFrames, static_cast<double>(NumFrames) / FMath::Max(RenderSampleRate, 1));
+	DriftCorrectionPpm.store(static_cast<float>(Drift->Estimator.GetCorrectionPpm()), std::memory_order_relaxed);
+
+	const int32 NumInput = FMath::Min(Drift->Resampler.GetInputFramesNeeded(NumFrames, Ratio), Drift->Resampler.GetMaxInputFrames());
+	float* InputFrames = Drift->InputFrames.GetData();
+	if (NumInput > 0 && FJackClientManager::ReadAudioFrames(Set, RenderChannels, NumInput, true, TArrayView<float>(InputFrames, NumInput * NumChannels)) == 0)
+	{
+		FMemory::Memzero(InputFrames, NumInput * NumChannels * sizeof(float));
+	}
+	const int32 NumOutput = Drift->Resampler.Process(InputFrames, NumInput, OutAudio, NumFrames, Ratio);
+	if (NumOutput < NumFrames)
+	{
+		FMemory::Memzero(OutAudio + NumOutput * NumChannels, (NumFrames - NumOutput) * NumChannels * sizeof(float));
+	}
+#else
+	FMemory::Memzero(OutAudio, NumSamples * sizeof(float));
+#endif
+	return NumSamples;
+}
@@ -0,0 +1,424 @@
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/Engine.h"
+#include "JackClientManager.h"
+#include "JackRoutingPreset.h"
+#include "JackServerController.h"
+#include "UEJackAudioLinkLog.h"
+#include "UEJackAudioLinkSubsystem.h"
+
+#if !UE_BUILD_SHIPPING && WITH_JACK
+
+// Hardware-free round-trip test: jackd runs the dummy driver, unreal_out_N is patched to unreal_in_N and
+// impulses written with WriteAudioBuffer are looked for in ReadAudioBuffer. The offset between the stream
+// position an impulse was written at and the one it is read back at is the round trip through the output
+// ring, JACK and the input ring; its spread across impulses is the jitter.
+
+namespace JackLoopbackTest
+{
+	static constexpr TCHAR BaseName[] = TEXT("unreal");
+	static constexpr float DetectionThreshold = 0.5f;
+
+	struct FResult
+	{
+		int32 BufferSize = 0;
+		int32 NumDetected = 0;
+		int32 NumLost = 0;
+		int64 MinOffset = 0;
+		int64 MaxOffset = 0;
+		double MeanOffset = 0.0;
+		double StdDevOffset = 0.0;
+	};
+
+	static bool WaitFor(TFunctionRef<bool()> Condition, double TimeoutSeconds)
+	{
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (!Condition())
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				return false;
+			}
+			FPlatformProcess::Sleep(0.05f);
+		}
+		return true;
+	}
+
+	// The tests own the server for their duration; they cannot share one started outside the plugin
+	static bool TakeOverServer()
+	{
+		FJackClientManager::Get().Disconnect();
+		FJackServerController::Get().StopServer();
+		if (FJackServerController::Get().IsAnyServerAvailable())
+		{
+			UE_LOG(LogJackAudioLink, Error, TEXT("Loopback test: another JACK server is running; stop it first"));
+			return false;
+		}
+		return true;
+	}
+
+	static bool StartClient(int32 SampleRate, int32 BufferSize, int32 NumChannels, bool bUseMultichannelRing = false)
+	{
+		FJackServerController& Server = FJackServerController::Get();
+		FJackClientManager& Client = FJackClientManager::Get();
+
+		if (!Server.StartServer(SampleRate, BufferSize, TEXT("dummy")))
+		{
+			return false;
+		}
+		if (!WaitFor([&Server]() { return Server.IsAnyServerAvailable(); }, 5.0))
+		{
+			UE_LOG(LogJackAudioLink, Error, TEXT("Loopback test: dummy server did not come up"));
+			return false;
+		}
+		if (!Client.Connect(TEXT("UnrealJackLoopbackTest"))
+			|| !Client.RegisterAudioPorts(NumChannels, NumChannels, BaseName, bUseMultichannelRing)
+			|| !Client.Activate())
+		{
+			UE_LOG(LogJackAudioLink, Error, TEXT("Loopback test: could not set up the JACK client"));
+			return false;
+		}
+		return true;
+	}
+
+	// Patches unreal_out_N to unreal_in_N (1-based)
+	static bool PatchChannel(int32 Ch)
+	{
+		FJackClientManager& Client = FJackClientManager::Get();
+		const FString ClientName = Client.GetClientName();
+		const FString Source = FString::Printf(TEXT("%s:%s_out_%d"), *ClientName, BaseName, Ch);
+		const FString Destination = FString::Printf(TEXT("%s:%s_in_%d"), *ClientName, BaseName, Ch);
+		if (!Client.ConnectPorts(Source, Destination))
+		{
+			UE_LOG(LogJackAudioLink, Error, TEXT("Loopback test: could not connect %s -> %s"), *Source, *Destination);
+			return false;
+		}
+		return true;
+	}
+
+	static bool StartLoopback(int32 SampleRate, int32 BufferSize, int32 NumChannels)
+	{
+		if (!StartClient(SampleRate, BufferSize, NumChannels))
+		{
+			return false;
+		}
+		for (int32 Ch = 1; Ch <= NumChannels; ++Ch)
+		{
+			if (!PatchChannel(Ch))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static void StopLoopback()
+	{
+		FJackClientManager::Get().Disconnect();
+		FJackServerController::Get().StopServer();
+	}
+
+	// Streams silence with an impulse every ImpulseSpacing samples on all channels, keeping about
+	// TargetFill samples queued ahead of what has come back, and matches impulses by stream position.
+	static FResult MeasureRoundTrip(int32 SampleRate, int32 BufferSize, int32 NumChannels, int32 NumImpulses)
+	{
+		FJackClientManager& Client = FJackClientManager::Get();
+		const int32 ImpulseSpacing = FMath::Max(SampleRate / 10, BufferSize * 8);
+		const int32 TargetFill = BufferSize * 2;
+		const int32 ChunkSize = BufferSize * 4;
+		const int64 LostAfter = SampleRate; // An impulse not seen within a second counts as lost
+
+		TArray<float> WriteChunk;
+		WriteChunk.SetNumZeroed(ChunkSize);
+		TArray<float> ReadChunk;
+		ReadChunk.SetNumZeroed(ChunkSize);
+
+		int64 NumWritten = 0;
+		int64 NextImpulse = TargetFill;
+		int32 NumImpulsesWritten = 0;
+		// Per channel: samples read back so far, and stream positions of impulses written but not yet seen
+		TArray<int64> NumRead;
+		NumRead.SetNumZeroed(NumChannels);
+		TArray<TArray<int64>> Pending;
+		Pending.SetNum(NumChannels);
+		TArray<int64> Offsets;
+
+		FResult Result;
+		Result.BufferSize = BufferSize;
+		const double Deadline = FPlatformTime::Seconds() + 2.0 + static_cast<double>(NumImpulses + 2) * ImpulseSpacing / SampleRate * 2.0;
+		while (FPlatformTime::Seconds() < Deadline)
+		{
+			// Keep the output ring TargetFill ahead of what has made it around the loop (channel 0 is the reference)
+			const int64 Wanted = NumRead[0] + TargetFill - NumWritten;
+			if (Wanted > 0)
+			{
+				const int32 NumToWrite = static_cast<int32>(FMath::Min<int64>(Wanted, ChunkSize));
+				FMemory::Memzero(WriteChunk.GetData(), NumToWrite * sizeof(float));
+				if (NumImpulsesWritten < NumImpulses && NextImpulse >= NumWritten && NextImpulse < NumWritten + NumToWrite)
+				{
+					WriteChunk[static_cast<int32>(NextImpulse - NumWritten)] = 1.0f;
+					for (TArray<int64>& ChannelPending : Pending)
+					{
+						ChannelPending.Add(NextImpulse);
+					}
+					++NumImpulsesWritten;
+					NextImpulse += ImpulseSpacing;
+				}
+				for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+				{
+					Client.WriteAudioBuffer(Ch, TConstArrayView<float>(WriteChunk.GetData(), NumToWrite));
+				}
+				NumWritten += NumToWrite;
+			}
+
+			bool bAllDone = NumImpulsesWritten == NumImpulses;
+			for (int32 Ch = 0; Ch < NumChannels; ++Ch)
+			{
+				const int32 NumSamples = Client.ReadAudioBuffer(Ch, TArrayView<float>(ReadChunk.GetData(), ChunkSize));
+				for (int32 i = 0; i < NumSamples; ++i)
+				{
+					if (ReadChunk[i] > DetectionThreshold && Pending[Ch].Num() > 0)
+					{
+						Offsets.Add(NumRead[Ch] + i - Pending[Ch][0]);
+						Pending[Ch].RemoveAt(0);
+					}
+				}
+				NumRead[Ch] += NumSamples;
+				while (Pending[Ch].Num() > 0 && NumRead[Ch] - Pending[Ch][0] > LostAfter)
+				{
+					++Result.NumLost;
+					Pending[Ch].RemoveAt(0);
+				}
+				bAllDone &= Pending[Ch].Num() == 0;
+			}
+			if (bAllDone)
+			{
+				break;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		for (const TArray<int64>& ChannelPending : Pending)
+		{
+			Result.NumLost += ChannelPending.Num();
+		}
+
+		Result.NumDetected = Offsets.Num();
+		if (Offsets.Num() > 0)
+		{
+			Result.MinOffset = Offsets[0];
+			Result.MaxOffset = Offsets[0];
+			double Sum = 0.0;
+			for (const int64 Offset : Offsets)
+			{
+				Result.MinOffset = FMath::Min(Result.MinOffset, Offset);
+				Result.MaxOffset = FMath::Max(Result.MaxOffset, Offset);
+				Sum += Offset;
+			}
+			Result.MeanOffset = Sum / Offsets.Num();
+			double SumSquares = 0.0;
+			for (const int64 Offset : Offsets)
+			{
+				SumSquares += FMath::Square(Offset - Result.MeanOffset);
+			}
+			Result.StdDevOffset = FMath::Sqrt(SumSquares / Offsets.Num());
+		}
+		return Result;
+	}
+
+	// JackAudioLink.Test.Loopback [BufferSizes=64,128,256,512,1024] [Impulses=32] [Channels=2] [SampleRate=48000]
+	static void Run(const TArray<FString>& Args)
+	{
+		TArray<int32> BufferSizes = { 64, 128, 256, 512, 1024 };
+		if (Args.Num() > 0)
+		{
+			TArray<FString> Parts;
+			Args[0].ParseIntoArray(Parts, TEXT(","));
+			BufferSizes.Reset();
+			for (const FString& Part : Parts)
+			{
+				const int32 Value = FCString::Atoi(*Part);
+				if (FMath::IsPowerOfTwo(Value) && Value >= 16 && Value <= 4096)
+				{
+					BufferSizes.Add(Value);
+				}
+			}
+		}
+		const int32 NumImpulses = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 32;
+		const int32 NumChannels = Args.Num() > 2 ? FMath::Clamp(FCString::Atoi(*Args[2]), 1, 64) : 2;
+		const int32 SampleRate = Args.Num() > 3 ? FMath::Max(FCString::Atoi(*Args[3]), 8000) : 48000;
+
+		if (!TakeOverServer())
+		{
+			return;
+		}
+
+		UE_LOG(LogJackAudioLink, Display, TEXT("Loopback test on the dummy driver: %d Hz, %d channel(s), %d impulses per buffer size"), SampleRate, NumChannels, NumImpulses);
+		UE_LOG(LogJackAudioLink, Display, TEXT("  period  detected  lost   min    max    mean   jitter (samples, stddev)"));
+		for (const int32 BufferSize : BufferSizes)
+		{
+			if (StartLoopback(SampleRate, BufferSize, NumChannels))
+			{
+				const FResult Result = MeasureRoundTrip(SampleRate, BufferSize, NumChannels, NumImpulses);
+				UE_LOG(LogJackAudioLink, Display, TEXT("  %6d  %8d  %4d  %5lld  %5lld  %7.1f  %6.2f"),
+					Result.BufferSize, Result.NumDetected, Result.NumLost, Result.MinOffset, Result.MaxOffset, Result.MeanOffset, Result.StdDevOffset);
+			}
+			else
+			{
+				UE_LOG(LogJackAudioLink, Display, TEXT("  %6d  setup failed"), BufferSize);
+			}
+			StopLoopback();
+		}
+		UE_LOG(LogJackAudioLink, Display, TEXT("Loopback test done; the JACK server and client are stopped (use RestartServer/ConnectClient to resume)"));
+	}
+
+	// Two inputs with only the first patched: a multichannel read of both must still deliver frames, the
+	// signal on the first channel and silence on the second. Returns false when the setup failed.
+	static bool CheckPartialInputs(bool bUseMultichannelRing)
+	{
+		constexpr int32 SampleRate = 48000;
+		constexpr int32 BufferSize = 256;
+		constexpr int32 ChunkSize = BufferSize * 4;
+		if (!StartClient(SampleRate, BufferSize, 2, bUseMultichannelRing) || !PatchChannel(1))
+		{
+			return false;
+		}
+		// Let the connection reach the process callback and drop what came in before it
+		FPlatformProcess::Sleep(0.2f);
+		FJackClientManager& Client = FJackClientManager::Get();
+		const int32 Channels[] = { 0, 1 };
+		TArray<float> Signal;
+		Signal.Init(0.5f, ChunkSize);
+		TArray<float> ReadChunk;
+		ReadChunk.SetNumZeroed(ChunkSize * 2);
+		Client.ReadAudioFrames(Channels, ChunkSize, false, ReadChunk);
+
+		int64 NumRead = 0;
+		int32 NumSignal = 0;
+		int32 NumLeaked = 0;
+		const double Deadline = FPlatformTime::Seconds() + 1.0;
+		while (FPlatformTime::Seconds() < Deadline)
+		{
+			Client.WriteAudioBuffer(0, Signal);
+			const int32 FramesRead = Client.ReadAudioFrames(Channels, ChunkSize, false, ReadChunk);
+			for (int32 Frame = 0; Frame < FramesRead; ++Frame)
+			{
+				NumSignal += ReadChunk[Frame] > DetectionThreshold * 0.5f ? 1 : 0;
+				NumLeaked += ReadChunk[ChunkSize + Frame] != 0.0f ? 1 : 0;
+			}
+			NumRead += FramesRead;
+			FPlatformProcess::Sleep(0.01f);
+		}
+
+		const bool bPassed = NumRead >= SampleRate / 2 && NumSignal > 0 && NumLeaked == 0;
+		UE_LOG(LogJackAudioLink, Display, TEXT("  %-12s  %s: %lld frames read, %d with signal on channel 1, %d non-silent on unpatched channel 2"),
+			bUseMultichannelRing ? TEXT("multichannel") : TEXT("per-port"), bPassed ? TEXT("PASS") : TEXT("FAIL"), NumRead, NumSignal, NumLeaked);
+		return true;
+	}
+
+	// JackAudioLink.Test.PartialInputs
+	static void RunPartialInputs(const TArray<FString>& /*Args*/)
+	{
+		if (!TakeOverServer())
+		{
+			return;
+		}
+		UE_LOG(LogJackAudioLink, Display, TEXT("Partial inputs test on the dummy driver: read channels 1+2 with only channel 1 patched"));
+		for (const bool bUseMultichannelRing : { false, true })
+		{
+			if (!CheckPartialInputs(bUseMultichannelRing))
+			{
+				UE_LOG(LogJackAudioLink, Display, TEXT("  %-12s  setup failed"), bUseMultichannelRing ? TEXT("multichannel") : TEXT("per-port"));
+			}
+			StopLoopback();
+		}
+	}
+
+	// Whether Source -> Destination is live on the server, asked through a client of our own
+	static bool IsPatched(jack_client_t* Probe, const char* Source, const char* Destination)
+	{
+		jack_port_t* Port = jack_port_by_name(Probe, Source);
+		return Port && jack_port_connected_to(Port, Destination);
+	}
+
+	// Captures a preset from a graph holding audio patches and a MIDI connection of another client, changes
+	// the audio patches, restores with the preset's default scope and checks that the audio patches are back
+	// and the MIDI connection was never touched. Returns false when the setup failed.
+	static bool CheckPresetRoundTrip()
+	{
+		UUEJackAudioLinkSubsystem* Subsys = GEngine ? GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>() : nullptr;
+		if (!Subsys || !StartClient(48000, 256, 2) || !PatchChannel(1))
+		{
+			return false;
+		}
+		jack_client_t* MidiClient = jack_client_open("UnrealJackMidiTest", JackNoStartServer, nullptr);
+		if (!MidiClient)
+		{
+			return false;
+		}
+		jack_port_register(MidiClient, "midi_out", JACK_DEFAULT_MIDI_TYPE, JackPortIsOutput, 0);
+		jack_port_register(MidiClient, "midi_in", JACK_DEFAULT_MIDI_TYPE, JackPortIsInput, 0);
+		const FString MidiOut = FString::Printf(TEXT("%s:midi_out"), UTF8_TO_TCHAR(jack_get_client_name(MidiClient)));
+		const FString MidiIn = FString::Printf(TEXT("%s:midi_in"), UTF8_TO_TCHAR(jack_get_client_name(MidiClient)));
+		const FString ClientName = FJackClientManager::Get().GetClientName();
+		const FString Out1 = FString::Printf(TEXT("%s:%s_out_1"), *ClientName, BaseName);
+		const FString In1 = FString::Printf(TEXT("%s:%s_in_1"), *ClientName, BaseName);
+		const FString Out2 = FString::Printf(TEXT("%s:%s_out_2"), *ClientName, BaseName);
+		const FString In2 = FString::Printf(TEXT("%s:%s_in_2"), *ClientName, BaseName);
+		bool bRan = false;
+		if (jack_activate(MidiClient) == 0 && jack_connect(MidiClient, TCHAR_TO_UTF8(*MidiOut), TCHAR_TO_UTF8(*MidiIn)) == 0
+			// The capture reads the graph index, which catches up with the patch on the event worker
+			&& WaitFor([&Out1, &In1]() { return FJackClientManager::Get().GetAllConnections().Contains(FJackRoutingEdge(Out1, In1)); }, 2.0))
+		{
+			bRan = true;
+			UJackRoutingPreset* Preset = NewObject<UJackRoutingPreset>();
+			Subsys->CaptureRoutingPresetInto(Preset);
+
+			FJackClientManager::Get().DisconnectPorts(Out1, In1);
+			PatchChannel(2);
+			const FJackRoutingResult Result = Subsys->RestoreRoutingPreset(Preset).Get();
+
+			const bool bAudioRestored = IsPatched(MidiClient, TCHAR_TO_UTF8(*Out1), TCHAR_TO_UTF8(*In1)) && !IsPatched(MidiClient, TCHAR_TO_UTF8(*Out2), TCHAR_TO_UTF8(*In2));
+			const bool bMidiKept = IsPatched(MidiClient, TCHAR_TO_UTF8(*MidiOut), TCHAR_TO_UTF8(*MidiIn));
+			const bool bPassed = bAudioRestored && bMidiKept && Result.NumFailed == 0;
+			UE_LOG(LogJackAudioLink, Display, TEXT("  %s: captured %d edge(s); restore %d connected, %d disconnected, %d failed; audio %s, MIDI %s"),
+				bPassed ? TEXT("PASS") : TEXT("FAIL"), Preset->Connections.Num(), Result.NumConnected, Result.NumDisconnected, Result.NumFailed,
+				bAudioRestored ? TEXT("restored") : TEXT("NOT restored"), bMidiKept ? TEXT("kept") : TEXT("DISCONNECTED"));
+		}
+		jack_client_close(MidiClient);
+		return bRan;
+	}
+
+	// JackAudioLink.Test.PresetRoundTrip
+	static void RunPresetRoundTrip(const TArray<FString>& /*Args*/)
+	{
+		if (!TakeOverServer())
+		{
+			return;
+		}
+		UE_LOG(LogJackAudioLink, Display, TEXT("Routing preset round trip on the dummy driver, with a MIDI connection in the graph"));
+		if (!CheckPresetRoundTrip())
+		{
+			UE_LOG(LogJackAudioLink, Display, TEXT("  setup failed"));
+		}
+		StopLoopback();
+	}
+}
+
+static FAutoConsoleCommand GJackLoopbackTestCommand(
+	TEXT("JackAudioLink.Test.Loopback"),
+	TEXT("Starts jackd on the dummy driver, patches unreal_out_N to unreal_in_N and measures the impulse round trip (offset and jitter in samples) per buffer size. Stops the plugin's server/client. Args: [BufferSizes=64,128,256,512,1024] [Impulses=32] [Channels=2] [SampleRate=48000]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&JackLoopbackTest::Run));
+
+static FAutoConsoleCommand GJackPartialInputsTestCommand(
+	TEXT("JackAudioLink.Test.PartialInputs"),
+	TEXT("Starts jackd on the dummy driver with two inputs, patches only the first and checks that reading both channels still delivers frames (signal on 1, silence on 2), in both ring modes. Stops the plugin's server/client."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&JackLoopbackTest::RunPartialInputs));
+
+static FAutoConsoleCommand GJackPresetRoundTripTestCommand(
+	TEXT("JackAudioLink.Test.PresetRoundTrip"),
+	TEXT("Starts jackd on the dummy driver, captures a routing preset from a graph that also holds a MIDI connection, changes the audio patch, restores the preset and checks the audio patch is back and the MIDI connection untouched. Stops the plugin's server/client."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&JackLoopbackTest::RunPresetRoundTrip));
+
+#endif // !UE_BUILD_SHIPPING && WITH_JACK
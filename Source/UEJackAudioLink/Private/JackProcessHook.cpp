@@ -0,0 +1,20 @@
+#include "JackProcessHook.h"
+#include "JackClientManager.h"
+
+void FJackProcessHooks::SetHook(IJackProcessHook* Hook)
+{
+	FJackClientManager::Get().SetProcessHook(Hook);
+}
+
+bool FJackProcessHooks::GetStreamFormat(uint32& OutSampleRate, uint32& OutBufferSize, int32& OutNumOutputs)
+{
+	FJackClientManager& Client = FJackClientManager::Get();
+	if (!Client.IsConnected())
+	{
+		return false;
+	}
+	OutSampleRate = Client.GetSampleRate();
+	OutBufferSize = Client.GetBufferSize();
+	OutNumOutputs = Client.GetNumOutputChannels();
+	return OutSampleRate > 0 && OutBufferSize > 0;
+}
@@ -0,0 +1,207 @@
+#include "JackSampleRateConverter.h"
+#include "Math/VectorRegister.h"
+
+namespace JackSampleRateConverter
+{
+	// Kaiser window shape and the share of the narrower Nyquist kept as passband
+	static constexpr double KaiserBeta = 8.0;
+	static constexpr double Passband = 0.9;
+
+	static double BesselI0(double X)
+	{
+		double Sum = 1.0;
+		double Term = 1.0;
+		for (int32 k = 1; k < 32; ++k)
+		{
+			Term *= (X / (2.0 * k)) * (X / (2.0 * k));
+			Sum += Term;
+			if (Term < Sum * 1.0e-12)
+			{
+				break;
+			}
+		}
+		return Sum;
+	}
+
+	static uint32 GreatestCommonDivisor(uint32 A, uint32 B)
+	{
+		while (B != 0)
+		{
+			const uint32 R = A % B;
+			A = B;
+			B = R;
+		}
+		return A;
+	}
+}
+
+bool FJackSampleRateConverter::Init(uint32 InInputRate, uint32 InOutputRate, int32 InNumChannels, int32 MaxInputFrames)
+{
+	using namespace JackSampleRateConverter;
+
+	Up = 0;
+	Down = 0;
+	InputRate = InInputRate;
+	OutputRate = InOutputRate;
+	if (InputRate == 0 || OutputRate == 0)
+	{
+		return false;
+	}
+	const uint32 Divisor = GreatestCommonDivisor(InputRate, OutputRate);
+	if (OutputRate / Divisor > static_cast<uint32>(MaxPhases) || InputRate / Divisor > static_cast<uint32>(MaxPhases))
+	{
+		return false;
+	}
+	Up = static_cast<int32>(OutputRate / Divisor);
+	Down = static_cast<int32>(InputRate / Divisor);
+	NumChannels = FMath::Max(InNumChannels, 1);
+	MaxInput = FMath::Max(MaxInputFrames, 1);
+
+	// Low-pass at the lower of the two Nyquist rates, in input-frame units, sampled at the Up phases
+	const double Cutoff = Passband * FMath::Min(1.0, static_cast<double>(Up) / Down);
+	const double HalfWidth = NumTaps / 2;
+	const double WindowNorm = BesselI0(KaiserBeta);
+	Coefficients.SetNumUninitialized(Up * NumTaps);
+	for (int32 PhaseIndex = 0; PhaseIndex < Up; ++PhaseIndex)
+	{
+		float* Row = Coefficients.GetData() + PhaseIndex * NumTaps;
+		double RowSum = 0.0;
+		for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+		{
+			// Distance from this tap's frame to the output time, which sits PhaseIndex/Up past the centre
+			const double X = (HalfWidth - 1.0) + static_cast<double>(PhaseIndex) / Up - Tap;
+			const double Arg = PI * Cutoff * X;
+			const double Sinc = FMath::Abs(Arg) < 1.0e-9 ? 1.0 : FMath::Sin(Arg) / Arg;
+			const double W = X / HalfWidth;
+			const double Window = FMath::Abs(W) < 1.0 ? BesselI0(KaiserBeta * FMath::Sqrt(1.0 - W * W)) / WindowNorm : 0.0;
+			const double Value = Cutoff * Sinc * Window;
+			Row[Tap] = static_cast<float>(Value);
+			RowSum += Value;
+		}
+		// Unity gain at DC for every phase, so the phase sweep does not modulate the level
+		for (int32 Tap = 0; Tap < NumTaps; ++Tap)
+		{
+			Row[Tap] = static_cast<float>(Row[Tap] / RowSum);
+		}
+	}
+
+	History.SetNumZeroed(NumChannels * NumTaps);
+	Work.SetNumZeroed(NumTaps + MaxInput + 4);
+	Reset();
+	return true;
+}
+
+void FJackSampleRateConverter::Reset()
+{
+	FMemory::Memzero(History.GetData(), History.Num() * sizeof(float));
+	Phase = 0;
+	Offset = 0;
+	PlannedInput = 0;
+	PlannedOutput = 0;
+	PlannedPhase = 0;
+	PlannedOffset = 0;
+}
+
+int32 FJackSampleRateConverter::GetMaxOutputFrames(int32 NumInputFrames) const
+{
+	if (!IsValid())
+	{
+		return 0;
+	}
+	// Outputs start at every input position up to NumInputFrames inclusive, Down/Up frames apart
+	return static_cast<int32>((static_cast<int64>(NumInputFrames) + 1) * Up / Down) + 1;
+}
+
+int32 FJackSampleRateConverter::GetInputFramesNeeded(int32 NumOutputFrames) const
+{
+	if (!IsValid() || NumOutputFrames <= 0)
+	{
+		return 0;
+	}
+	// The last output's first tap must lie within the block
+	return Offset + static_cast<int32>((Phase + static_cast<int64>(NumOutputFrames - 1) * Down) / Up);
+}
+
+int32 FJackSampleRateConverter::Plan(int32 NumInputFrames, int32 MaxOutputFrames)
+{
+	PlannedInput = FMath::Clamp(NumInputFrames, 0, MaxInput);
+	PlannedOutput = 0;
+	if (!IsValid())
+	{
+		return 0;
+	}
+	int32 P = Phase;
+	int32 O = Offset;
+	while (PlannedOutput < MaxOutputFrames && O <= PlannedInput)
+	{
+		++PlannedOutput;
+		P += Down;
+		O += P / Up;
+		P %= Up;
+	}
+	PlannedPhase = P;
+	PlannedOffset = FMath::Max(O - PlannedInput, 0);
+	return PlannedOutput;
+}
+
+void FJackSampleRateConverter::ProcessChannel(int32 Channel, const float* Input, float* Output)
+{
+	if (!IsValid() || Channel < 0 || Channel >= NumChannels)
+	{
+		return;
+	}
+	float* ChannelHistory = History.GetData() + Channel * NumTaps;
+	float* Buffer = Work.GetData();
+	FMemory::Memcpy(Buffer, ChannelHistory, NumTaps * sizeof(float));
+	if (Input)
+	{
+		FMemory::Memcpy(Buffer + NumTaps, Input, PlannedInput * sizeof(float));
+	}
+	else
+	{
+		FMemory::Memzero(Buffer + NumTaps, PlannedInput * sizeof(float));
+	}
+
+	int32 P = Phase;
+	int32 O = Offset;
+	const float* Table = Coefficients.GetData();
+	alignas(16) float Lanes[4];
+	for (int32 n = 0; n < PlannedOutput; ++n)
+	{
+		const float* Taps = Buffer + O;
+		const float* Row = Table + P * NumTaps;
+		// Two accumulators so consecutive multiply-adds do not wait on each other
+		VectorRegister4Float SumA = VectorMultiply(VectorLoad(Taps), VectorLoadAligned(Row));
+		VectorRegister4Float SumB = VectorMultiply(VectorLoad(Taps + 4), VectorLoadAligned(Row + 4));
+		for (int32 Tap = 8; Tap < NumTaps; Tap += 8)
+		{
+			SumA = VectorMultiplyAdd(VectorLoad(Taps + Tap), VectorLoadAligned(Row + Tap), SumA);
+			SumB = VectorMultiplyAdd(VectorLoad(Taps + Tap + 4), VectorLoadAligned(Row + Tap + 4), SumB);
+		}
+		VectorStoreAligned(VectorAdd(SumA, SumB), Lanes);
+		Output[n] = (Lanes[0] + Lanes[1]) + (Lanes[2] + Lanes[3]);
+
+		P += Down;
+		O += P / Up;
+		P %= Up;
+	}
+
+	// The last NumTaps frames of history + input become the next block's history
+	FMemory::Memcpy(ChannelHistory, Buffer + PlannedInput, NumTaps * sizeof(float));
+}
+
+void FJackSampleRateConverter::ClearChannel(int32 Channel)
+{
+	if (Channel >= 0 && Channel < NumChannels)
+	{
+		FMemory::Memzero(History.GetData() + Channel * NumTaps, NumTaps * sizeof(float));
+	}
+}
+
+void FJackSampleRateConverter::Commit()
+{
+	Phase = PlannedPhase;
+	Offset = PlannedOffset;
+	PlannedInput = 0;
+	PlannedOutput = 0;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Fixed-ratio polyphase sample-rate converter for planar channels, run by the process callback between the
+// JACK port buffers and the rings. The rate ratio is reduced to Up/Down (output/input) and a Kaiser-windowed
+// sinc is split into Up phases of NumTaps taps, so every output sample is one SIMD dot product.
+// All channels of a block share the phase: Plan the block, ProcessChannel (or ClearChannel) each channel,
+// then Commit. Nothing allocates after Init.
+class FJackSampleRateConverter
+{
+public:
+	static constexpr int32 NumTaps = 64;
+	// Ratios that reduce to more phases than this are refused (coefficient table size)
+	static constexpr int32 MaxPhases = 4096;
+
+	// MaxInputFrames bounds the input of one block. Returns false, leaving the converter unusable, when the
+	// rates are zero or reduce to more than MaxPhases phases.
+	bool Init(uint32 InInputRate, uint32 InOutputRate, int32 InNumChannels, int32 MaxInputFrames);
+	void Reset();
+
+	bool IsValid() const { return Up > 0; }
+	uint32 GetInputRate() const { return InputRate; }
+	uint32 GetOutputRate() const { return OutputRate; }
+	int32 GetNumChannels() const { return NumChannels; }
+	int32 GetMaxInputFrames() const { return MaxInput; }
+	// Upper bound on the outputs of a block of NumInputFrames
+	int32 GetMaxOutputFrames(int32 NumInputFrames) const;
+	// Input frames the next block needs to produce exactly NumOutputFrames
+	int32 GetInputFramesNeeded(int32 NumOutputFrames) const;
+	// Group delay of the filter, in input frames
+	int32 GetLatencyInputFrames() const { return NumTaps / 2; }
+
+	// Fixes the next block: returns how many outputs NumInputFrames input frames yield, at most MaxOutputFrames.
+	// When capping, pass no more input than GetInputFramesNeeded(MaxOutputFrames) or the excess is lost.
+	int32 Plan(int32 NumInputFrames, int32 MaxOutputFrames);
+	// Converts one channel over the planned block: reads the block's input frames, writes its outputs
+	void ProcessChannel(int32 Channel, const float* Input, float* Output);
+	// Silences the history of a channel that sat the block out (e.g. an unconnected port)
+	void ClearChannel(int32 Channel);
+	// Moves the shared phase past the planned block
+	void Commit();
+
+private:
+	uint32 InputRate = 0;
+	uint32 OutputRate = 0;
+	int32 Up = 0;
+	int32 Down = 0;
+	int32 NumChannels = 0;
+	int32 MaxInput = 0;
+
+	// Up rows of NumTaps, row p for outputs p/Up of an input frame past the filter centre
+	TArray<float, TAlignedHeapAllocator<16>> Coefficients;
+	// Last NumTaps input frames of each channel
+	TArray<float> History;
+	// History followed by the block's input, for one channel at a time
+	TArray<float> Work;
+
+	// Next output: phase p and the first tap's frame, relative to the start of the history
+	int32 Phase = 0;
+	int32 Offset = 0;
+
+	int32 PlannedInput = 0;
+	int32 PlannedOutput = 0;
+	int32 PlannedPhase = 0;
+	int32 PlannedOffset = 0;
+};
@@ -0,0 +1,128 @@
+#include "JackSubmixOutputBridge.h"
+#include "UEJackAudioLinkLog.h"
+
+FJackSubmixOutputBridge::FJackSubmixOutputBridge(const TArray<int32>& ChannelMap, bool bInCompensateDrift, double DriftBandwidthHz, double MaxDriftCorrectionPpm)
+	: bCompensateDrift(bInCompensateDrift)
+{
+	for (int32 SubmixChannel = 0; SubmixChannel < ChannelMap.Num(); ++SubmixChannel)
+	{
+		if (ChannelMap[SubmixChannel] >= 0)
+		{
+			OutputChannels.Add(ChannelMap[SubmixChannel]);
+			SubmixChannels.Add(SubmixChannel);
+		}
+	}
+
+	if (SubmixChannels.Num() > 0)
+	{
+		ResampleWidth = SubmixChannels.Last() + 1;
+		DriftEstimator.Configure(DriftBandwidthHz, MaxDriftCorrectionPpm);
+		Resampler.Init(ResampleWidth, MaxBlockFrames);
+		GatheredFrames.SetNumZeroed(ResampleWidth * MaxBlockFrames);
+		ResampledFrames.SetNumZeroed(ResampleWidth * MaxBlockFrames * MaxUpsampling);
+	}
+}
+
+void FJackSubmixOutputBridge::OnNewSubmixBuffer(const USoundSubmix* /*OwningSubmix*/, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double /*AudioClock*/)
+{
+#if WITH_JACK
+	if (!AudioData || NumChannels <= 0 || SampleRate <= 0)
+	{
+		return;
+	}
+	FJackClientManager& Client = FJackClientManager::Get();
+	const uint32 Generation = Client.GetPortSetGeneration();
+	if (Generation != PortSetGeneration)
+	{
+		PortSet = Client.GetPortSet();
+		PortSetGeneration = Generation;
+	}
+	if (!PortSet)
+	{
+		return;
+	}
+	const FJackPortSet& Set = *PortSet;
+	// With output rate conversion the rings run at their own rate, which is what this block has to match
+	const uint32 RingSampleRate = Client.GetRingSampleRate(Set, false);
+
+	// A new rate restarts the loop and the resampler from silence
+	if (LastSampleRate.exchange(SampleRate, std::memory_order_relaxed) != SampleRate)
+	{
+		DriftEstimator.Reset();
+		Resampler.Reset();
+		if (RingSampleRate != 0 && RingSampleRate != static_cast<uint32>(SampleRate))
+		{
+			UE_LOG(LogJackAudioLink, Log, TEXT("Submix output runs at %d Hz, the output rings at %u Hz; converting"), SampleRate, RingSampleRate);
+		}
+	}
+
+	// Submix channels beyond what this submix renders are skipped (they are sorted, so this is a prefix)
+	int32 NumMapped = 0;
+	while (NumMapped < SubmixChannels.Num() && SubmixChannels[NumMapped] < NumChannels)
+	{
+		++NumMapped;
+	}
+	if (NumMapped == 0)
+	{
+		return;
+	}
+	const TConstArrayView<int32> Outputs = MakeArrayView(OutputChannels.GetData(), NumMapped);
+	const TConstArrayView<int32> Sources = MakeArrayView(SubmixChannels.GetData(), NumMapped);
+
+	const int32 NumFrames = NumSamples / NumChannels;
+	const double NominalRatio = RingSampleRate > 0 ? static_cast<double>(SampleRate) / RingSampleRate : 1.0;
+	const bool bResample = (bCompensateDrift || NominalRatio != 1.0) && NominalRatio * MaxUpsampling >= 1.0;
+	if (!bResample || NumFrames > MaxBlockFrames)
+	{
+		if (bResample && !bWarnedOversizedBlock)
+		{
+			bWarnedOversizedBlock = true;
+			UE_LOG(LogJackAudioLink, Warning, TEXT("Submix blocks of %d frames exceed the %d the output bridge resamples; writing them unconverted"), NumFrames, MaxBlockFrames);
+		}
+		const int32 FramesWritten = FJackClientManager::WriteInterleavedFrames(Set, Outputs, Sources, NumChannels, NumFrames, AudioData);
+		if (FramesWritten < NumFrames)
+		{
+			DroppedFrames.fetch_add(NumFrames - FramesWritten, std::memory_order_relaxed);
+		}
+		return;
+	}
+
+	// The resampler runs on ResampleWidth-float frames; narrow or pad the submix layout when it differs
+	const float* Frames = AudioData;
+	if (NumChannels != ResampleWidth)
+	{
+		const int32 NumCopied = FMath::Min(NumChannels, ResampleWidth);
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			float* Dest = GatheredFrames.GetData() + Frame * ResampleWidth;
+			FMemory::Memcpy(Dest, AudioData + Frame * NumChannels, NumCopied * sizeof(float));
+			FMemory::Memzero(Dest + NumCopied, (ResampleWidth - NumCopied) * sizeof(float));
+		}
+		Frames = GatheredFrames.GetData();
+	}
+
+	// Fill is sampled before this block goes in, so it reads the same point of the cycle every time
+	double Ratio = NominalRatio;
+	if (bCompensateDrift)
+	{
+		const int32 BlockFrames = FMath::Max(FMath::RoundToInt(NumFrames / NominalRatio), 1);
+		const int32 TargetFill = BlockFrames + Client.GetRingPeriodFrames(Set, false);
+		const int32 Fill = FJackClientManager::GetBufferedFrames(Set, false, OutputChannels[0]);
+		Ratio *= DriftEstimator.Update(Fill, TargetFill, BlockFrames, static_cast<double>(NumFrames) / SampleRate);
+		DriftCorrectionPpm.store(static_cast<float>(DriftEstimator.GetCorrectionPpm()), std::memory_order_relaxed);
+	}
+
+	const int32 NumResampled = Resampler.Process(Frames, NumFrames, ResampledFrames.GetData(), ResampledFrames.Num() / ResampleWidth, Ratio);
+	const int32 FramesWritten = FJackClientManager::WriteInterleavedFrames(Set, Outputs, Sources, ResampleWidth, NumResampled, ResampledFrames.GetData());
+	if (FramesWritten < NumResampled)
+	{
+		DroppedFrames.fetch_add(NumResampled - FramesWritten, std::memory_order_relaxed);
+	}
+#endif
+}
+
+const FString& FJackSubmixOutputBridge::GetListenerName() const
+{
+	static const FString ListenerName(TEXT("JackSubmixOutputBridge"));
+	return ListenerName;
+}
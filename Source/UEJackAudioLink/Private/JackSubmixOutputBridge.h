@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ISubmixBufferListener.h"
+#include "JackClientManager.h"
+#include "JackDriftCompensation.h"
+#include <atomic>
+
+// Pushes a submix's rendered buffers into the JACK output rings from the audio render thread, so game
+// audio reaches JACK one render block after mixing instead of waiting for the next game tick.
+// The channel map is fixed at construction; remap by registering a new bridge.
+// The mixer and JACK run on separate clocks, so the block is resampled on its way into the rings: at the
+// nominal rate ratio when they differ, corrected by a DLL that holds the output ring fill at one mixer
+// block plus one JACK period when drift compensation is on.
+class FJackSubmixOutputBridge : public ISubmixBufferListener
+{
+public:
+	// ChannelMap[k] is the 0-based JACK output for submix channel k, or INDEX_NONE to skip it
+	FJackSubmixOutputBridge(const TArray<int32>& ChannelMap, bool bInCompensateDrift, double DriftBandwidthHz, double MaxDriftCorrectionPpm);
+
+	//~ Begin ISubmixBufferListener
+	virtual void OnNewSubmixBuffer(const USoundSubmix* OwningSubmix, float* AudioData, int32 NumSamples, int32 NumChannels, const int32 SampleRate, double AudioClock) override;
+	virtual const FString& GetListenerName() const override;
+	//~ End ISubmixBufferListener
+
+	// Frames the output rings could not take (full rings), for diagnostics
+	uint64 GetDroppedFrames() const { return DroppedFrames.load(std::memory_order_relaxed); }
+	// Current clock-drift correction on top of the nominal rate ratio (ppm)
+	float GetDriftCorrectionPpm() const { return DriftCorrectionPpm.load(std::memory_order_relaxed); }
+
+private:
+	// Largest mixer block resampled, and the largest JACK/mixer rate ratio it is sized for; bigger blocks
+	// are written as they are
+	static constexpr int32 MaxBlockFrames = 4096;
+	static constexpr int32 MaxUpsampling = 4;
+
+	// Parallel arrays in ascending submix channel order, built once so the render thread never allocates
+	TArray<int32> OutputChannels;
+	TArray<int32> SubmixChannels;
+
+	// Render-thread state. The resampler covers submix channels 0 .. ResampleWidth-1 (up to the highest mapped one)
+	bool bCompensateDrift = true;
+	int32 ResampleWidth = 0;
+	FJackDriftEstimator DriftEstimator;
+	FJackVariableResampler Resampler;
+	TArray<float> GatheredFrames;
+	TArray<float> ResampledFrames;
+	bool bWarnedOversizedBlock = false;
+#if WITH_JACK
+	// Port set the render thread writes to, refetched only when the manager publishes a new one, so a
+	// block costs no PortSetLock round-trips
+	FJackPortSetPtr PortSet;
+	uint32 PortSetGeneration = 0;
+#endif
+
+	std::atomic<uint64> DroppedFrames{0};
+	std::atomic<int32> LastSampleRate{0};
+	std::atomic<float> DriftCorrectionPpm{0.0f};
+};
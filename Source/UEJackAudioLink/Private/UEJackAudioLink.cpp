@@ -214,7 +214,7 @@ void FUEJackAudioLinkModule::StartupModule()
 		if (FJackClientManager::Get().Connect(ClientName))
 		{
 			UE_LOG(LogJackAudioLink, Display, TEXT("JACK client connected successfully"));
-			if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal")))
+			if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal"), Settings->bUseMultichannelRing))
 			{
 				UE_LOG(LogJackAudioLink, Display, TEXT("Plugin startup: Audio ports registered: %d inputs, %d outputs"), Settings->InputChannels, Settings->OutputChannels);
 				if (FJackClientManager::Get().Activate())
@@ -457,7 +457,7 @@ FReply FUEJackAudioLinkModule::OnRestartServerClicked()
 		if (FJackClientManager::Get().Connect(ClientName))
 		{
 			UE_LOG(LogJackAudioLink, Display, TEXT("JACK client reconnected successfully"));
-			if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal")))
+			if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal"), Settings->bUseMultichannelRing))
 			{
 				UE_LOG(LogJackAudioLink, Display, TEXT("Audio ports re-registered: %d inputs, %d outputs"), Settings->InputChannels, Settings->OutputChannels);
 				if (FJackClientManager::Get().Activate())
@@ -522,7 +522,7 @@ FReply FUEJackAudioLinkModule::OnConnectClientClicked()
 		UE_LOG(LogJackAudioLink, Display, TEXT("JACK client connected successfully"));
 		UE_LOG(LogJackAudioLink, Display, TEXT("Registering audio ports: %d inputs, %d outputs"), Settings->InputChannels, Settings->OutputChannels);
 		
-		if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal")))
+		if (FJackClientManager::Get().RegisterAudioPorts(Settings->InputChannels, Settings->OutputChannels, TEXT("unreal"), Settings->bUseMultichannelRing))
 		{
 			UE_LOG(LogJackAudioLink, Display, TEXT("Audio ports registered successfully"));
 			if (FJackClientManager::Get().Activate())
@@ -1,5 +1,6 @@
 #include "UEJackAudioLinkBPLibrary.h"
 #include "UEJackAudioLinkSubsystem.h"
+#include "JackRoutingPreset.h"
 #include "Engine/Engine.h"
 
 bool UUEJackAudioLinkBPLibrary::RestartServer(int32 SampleRate, int32 BufferSize)
@@ -85,6 +86,66 @@ bool UUEJackAudioLinkBPLibrary::WriteAudioBuffer(int32 ChannelIndex, const TArra
 	return false;
 }
 
+int32 UUEJackAudioLinkBPLibrary::ReadAudioBufferInto(int32 ChannelIndex, int32 NumSamples, TArray<float>& Buffer)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->ReadAudioBufferInto(ChannelIndex, NumSamples, Buffer);
+		}
+	}
+	return 0;
+}
+
+int32 UUEJackAudioLinkBPLibrary::ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, TArray<float>& Samples)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->ReadAudioFrames(FirstChannel, NumChannels, NumFrames, Layout, Samples);
+		}
+	}
+	return 0;
+}
+
+int32 UUEJackAudioLinkBPLibrary::WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, const TArray<float>& Samples)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->WriteAudioFrames(FirstChannel, NumChannels, Layout, Samples);
+		}
+	}
+	return 0;
+}
+
+int32 UUEJackAudioLinkBPLibrary::ReadAudioFramesMasked(int64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, TArray<float>& Samples)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->ReadAudioFramesMasked(ChannelMask, NumFrames, Layout, Samples);
+		}
+	}
+	return 0;
+}
+
+int32 UUEJackAudioLinkBPLibrary::WriteAudioFramesMasked(int64 ChannelMask, EJackAudioFrameLayout Layout, const TArray<float>& Samples)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->WriteAudioFramesMasked(ChannelMask, Layout, Samples);
+		}
+	}
+	return 0;
+}
+
 float UUEJackAudioLinkBPLibrary::GetInputLevel(int32 ChannelIndex)
 {
 	if (GEngine)
@@ -97,6 +158,18 @@ float UUEJackAudioLinkBPLibrary::GetInputLevel(int32 ChannelIndex)
 	return 0.0f;
 }
 
+float UUEJackAudioLinkBPLibrary::GetInputPeakLevel(int32 ChannelIndex)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetInputPeakLevel(ChannelIndex);
+		}
+	}
+	return 0.0f;
+}
+
 int32 UUEJackAudioLinkBPLibrary::GetSampleRate()
 {
 	if (GEngine)
@@ -133,6 +206,138 @@ float UUEJackAudioLinkBPLibrary::GetCpuLoad()
 	return 0.0f;
 }
 
+void UUEJackAudioLinkBPLibrary::GetActivePortCounts(int32& ActivePorts, int32& RegisteredPorts)
+{
+	ActivePorts = 0;
+	RegisteredPorts = 0;
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->GetActivePortCounts(ActivePorts, RegisteredPorts);
+		}
+	}
+}
+
+int64 UUEJackAudioLinkBPLibrary::GetAudioBufferAllocationCount()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetAudioBufferAllocationCount();
+		}
+	}
+	return 0;
+}
+
+bool UUEJackAudioLinkBPLibrary::StartSubmixOutput(USoundSubmix* Submix, const TArray<int32>& ChannelMap)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->StartSubmixOutput(Submix, ChannelMap);
+		}
+	}
+	return false;
+}
+
+void UUEJackAudioLinkBPLibrary::StopSubmixOutput()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->StopSubmixOutput();
+		}
+	}
+}
+
+float UUEJackAudioLinkBPLibrary::GetSubmixOutputDriftPpm()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetSubmixOutputDriftPpm();
+		}
+	}
+	return 0.0f;
+}
+
+FJackCallbackTimingStats UUEJackAudioLinkBPLibrary::GetCallbackTimingStats()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetCallbackTimingStats();
+		}
+	}
+	return FJackCallbackTimingStats();
+}
+
+void UUEJackAudioLinkBPLibrary::ResetCallbackTimingStats()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->ResetCallbackTimingStats();
+		}
+	}
+}
+
+bool UUEJackAudioLinkBPLibrary::GetChannelLatency(EJackPortDirection Direction, int32 ChannelIndex, FJackChannelLatency& OutLatency)
+{
+	OutLatency = FJackChannelLatency();
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetChannelLatency(Direction, ChannelIndex, OutLatency);
+		}
+	}
+	return false;
+}
+
+int64 UUEJackAudioLinkBPLibrary::GetXrunCount()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetXrunCount();
+		}
+	}
+	return 0;
+}
+
+float UUEJackAudioLinkBPLibrary::GetXrunRate(float WindowSeconds)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetXrunRate(WindowSeconds);
+		}
+	}
+	return 0.0f;
+}
+
+TArray<FJackXrunInfo> UUEJackAudioLinkBPLibrary::GetRecentXruns()
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->GetRecentXruns();
+		}
+	}
+	return TArray<FJackXrunInfo>();
+}
+
 TArray<FString> UUEJackAudioLinkBPLibrary::GetConnectedClients()
 {
 	if (GEngine)
@@ -208,6 +413,75 @@ bool UUEJackAudioLinkBPLibrary::DisconnectPortsByIndex(EJackPortDirection Source
 	return false;
 }
 
+void UUEJackAudioLinkBPLibrary::ApplyRoutingMatrix(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope, const FOnJackRoutingApplied& OnComplete)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->ApplyRoutingMatrix(Edges, Scope, OnComplete);
+		}
+	}
+}
+
+FJackRoutingEdge UUEJackAudioLinkBPLibrary::MakeRoutingEdgeByIndex(const FString& SourceClientName, int32 SourcePortNumber, const FString& DestClientName, int32 DestPortNumber)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->MakeRoutingEdgeByIndex(SourceClientName, SourcePortNumber, DestClientName, DestPortNumber);
+		}
+	}
+	return FJackRoutingEdge();
+}
+
+UJackRoutingPreset* UUEJackAudioLinkBPLibrary::CaptureRoutingPreset(FName PresetName)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->CaptureRoutingPreset(PresetName);
+		}
+	}
+	return nullptr;
+}
+
+void UUEJackAudioLinkBPLibrary::CaptureRoutingPresetInto(UJackRoutingPreset* Preset)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->CaptureRoutingPresetInto(Preset);
+		}
+	}
+}
+
+UJackRoutingPreset* UUEJackAudioLinkBPLibrary::FindRoutingPreset(FName PresetName)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			return Subsys->FindRoutingPreset(PresetName);
+		}
+	}
+	return nullptr;
+}
+
+void UUEJackAudioLinkBPLibrary::RestoreRoutingPreset(UJackRoutingPreset* Preset, const FOnJackRoutingApplied& OnComplete)
+{
+	if (GEngine)
+	{
+		if (UUEJackAudioLinkSubsystem* Subsys = GEngine->GetEngineSubsystem<UUEJackAudioLinkSubsystem>())
+		{
+			Subsys->RestoreRoutingPreset(Preset, OnComplete);
+		}
+	}
+}
+
 FString UUEJackAudioLinkBPLibrary::GetJackClientName()
 {
 	if (GEngine)
@@ -2,22 +2,38 @@
 #include "JackServerController.h"
 #include "JackClientManager.h"
 #include "JackAudioLinkSettings.h"
+#include "JackSubmixOutputBridge.h"
+#include "JackRoutingPreset.h"
+#include "AudioDevice.h"
+#include "Engine/Engine.h"
+#include "Sound/SoundSubmix.h"
 #include "UEJackAudioLinkLog.h"
 #include "Containers/Ticker.h"
+#include "CoreGlobals.h"
+#include "Async/Async.h"
 
 void UUEJackAudioLinkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	GetDefault<UJackAudioLinkSettings>()->ApplyMeteringSettings();
+	GetDefault<UJackAudioLinkSettings>()->ApplySampleRateConversionSettings();
+	XrunTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UUEJackAudioLinkSubsystem::TickXruns));
 	UE_LOG(LogJackAudioLink, Log, TEXT("UEJackAudioLinkSubsystem initialized"));
 }
 
 void UUEJackAudioLinkSubsystem::Deinitialize()
 {
+	StopSubmixOutput();
 	if (DebugTickHandle.IsValid())
 	{
 		FTSTicker::GetCoreTicker().RemoveTicker(DebugTickHandle);
 		DebugTickHandle.Reset();
 	}
+	if (XrunTickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(XrunTickHandle);
+		XrunTickHandle.Reset();
+	}
 	Super::Deinitialize();
 }
 
@@ -37,7 +53,8 @@ bool UUEJackAudioLinkSubsystem::ConnectClient(const FString& ClientName, int32 N
 	{
 		return false;
 	}
-	if (!FJackClientManager::Get().RegisterAudioPorts(NumInputs, NumOutputs, TEXT("unreal")))
+	const UJackAudioLinkSettings* Settings = GetDefault<UJackAudioLinkSettings>();
+	if (!FJackClientManager::Get().RegisterAudioPorts(NumInputs, NumOutputs, TEXT("unreal"), Settings && Settings->bUseMultichannelRing))
 	{
 		return false;
 	}
@@ -95,6 +112,220 @@ bool UUEJackAudioLinkSubsystem::WriteAudioBuffer(int32 ChannelIndex, const TArra
 	return false;
 }
 
+int32 UUEJackAudioLinkSubsystem::ReadAudioBufferInto(int32 ChannelIndex, int32 NumSamples, TArray<float>& Buffer)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().ReadAudioBuffer(ChannelIndex, NumSamples, Buffer);
+	}
+#endif
+	FJackClientManager::Get().SizeAudioBuffer(Buffer, NumSamples);
+	FMemory::Memzero(Buffer.GetData(), Buffer.Num() * sizeof(float));
+	return 0;
+}
+
+int32 UUEJackAudioLinkSubsystem::ReadAudioBuffer(int32 ChannelIndex, TArrayView<float> OutSamples)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().ReadAudioBuffer(ChannelIndex, OutSamples);
+	}
+#endif
+	FMemory::Memzero(OutSamples.GetData(), OutSamples.Num() * sizeof(float));
+	return 0;
+}
+
+bool UUEJackAudioLinkSubsystem::WriteAudioBuffer(int32 ChannelIndex, TConstArrayView<float> AudioData)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().WriteAudioBuffer(ChannelIndex, AudioData);
+	}
+#endif
+	return false;
+}
+
+using FJackChannelList = TArray<int32, TInlineAllocator<256>>;
+
+static FJackChannelList MakeChannelRange(int32 FirstChannel, int32 NumChannels)
+{
+	FJackChannelList Channels;
+	for (int32 i = 0; i < NumChannels; ++i)
+	{
+		Channels.Add(FirstChannel + i);
+	}
+	return Channels;
+}
+
+static FJackChannelList MakeChannelMask(uint64 ChannelMask)
+{
+	FJackChannelList Channels;
+	for (int32 Bit = 0; Bit < 64; ++Bit)
+	{
+		if (ChannelMask & (1ull << Bit))
+		{
+			Channels.Add(Bit);
+		}
+	}
+	return Channels;
+}
+
+static int32 ReadFramesForChannels(const FJackChannelList& Channels, int32 NumFrames, EJackAudioFrameLayout Layout, TArrayView<float> OutSamples)
+{
+#if WITH_JACK
+	if (FJackClientManager::Get().IsConnected())
+	{
+		return FJackClientManager::Get().ReadAudioFrames(Channels, NumFrames, Layout == EJackAudioFrameLayout::Interleaved, OutSamples);
+	}
+#endif
+	FMemory::Memzero(OutSamples.GetData(), OutSamples.Num() * sizeof(float));
+	return 0;
+}
+
+static int32 WriteFramesForChannels(const FJackChannelList& Channels, EJackAudioFrameLayout Layout, TConstArrayView<float> Samples)
+{
+#if WITH_JACK
+	if (FJackClientManager::Get().IsConnected() && Channels.Num() > 0)
+	{
+		const int32 NumFrames = Samples.Num() / Channels.Num();
+		return FJackClientManager::Get().WriteAudioFrames(Channels, NumFrames, Layout == EJackAudioFrameLayout::Interleaved, Samples);
+	}
+#endif
+	return 0;
+}
+
+int32 UUEJackAudioLinkSubsystem::ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, TArray<float>& Samples)
+{
+	FJackClientManager::Get().SizeAudioBuffer(Samples, FMath::Max(NumChannels, 0) * FMath::Max(NumFrames, 0));
+	return ReadAudioFrames(FirstChannel, NumChannels, NumFrames, Layout, TArrayView<float>(Samples));
+}
+
+int32 UUEJackAudioLinkSubsystem::WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, const TArray<float>& Samples)
+{
+	return WriteAudioFrames(FirstChannel, NumChannels, Layout, TConstArrayView<float>(Samples));
+}
+
+int32 UUEJackAudioLinkSubsystem::ReadAudioFramesMasked(int64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, TArray<float>& Samples)
+{
+	FJackClientManager::Get().SizeAudioBuffer(Samples, FMath::CountBits(static_cast<uint64>(ChannelMask)) * FMath::Max(NumFrames, 0));
+	return ReadAudioFrames(static_cast<uint64>(ChannelMask), NumFrames, Layout, TArrayView<float>(Samples));
+}
+
+int32 UUEJackAudioLinkSubsystem::WriteAudioFramesMasked(int64 ChannelMask, EJackAudioFrameLayout Layout, const TArray<float>& Samples)
+{
+	return WriteAudioFrames(static_cast<uint64>(ChannelMask), Layout, TConstArrayView<float>(Samples));
+}
+
+int32 UUEJackAudioLinkSubsystem::ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, TArrayView<float> OutSamples)
+{
+	return ReadFramesForChannels(MakeChannelRange(FirstChannel, NumChannels), NumFrames, Layout, OutSamples);
+}
+
+int32 UUEJackAudioLinkSubsystem::WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, TConstArrayView<float> Samples)
+{
+	return WriteFramesForChannels(MakeChannelRange(FirstChannel, NumChannels), Layout, Samples);
+}
+
+int32 UUEJackAudioLinkSubsystem::ReadAudioFrames(uint64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, TArrayView<float> OutSamples)
+{
+	return ReadFramesForChannels(MakeChannelMask(ChannelMask), NumFrames, Layout, OutSamples);
+}
+
+int32 UUEJackAudioLinkSubsystem::WriteAudioFrames(uint64 ChannelMask, EJackAudioFrameLayout Layout, TConstArrayView<float> Samples)
+{
+	return WriteFramesForChannels(MakeChannelMask(ChannelMask), Layout, Samples);
+}
+
+bool UUEJackAudioLinkSubsystem::StartSubmixOutput(USoundSubmix* Submix, const TArray<int32>& ChannelMap)
+{
+	StopSubmixOutput();
+#if WITH_JACK
+	if (!IsClientConnected() || !GEngine)
+	{
+		return false;
+	}
+	FAudioDeviceHandle AudioDevice = GEngine->GetMainAudioDevice();
+	if (!AudioDevice.IsValid())
+	{
+		UE_LOG(LogJackAudioLink, Warning, TEXT("StartSubmixOutput: no audio device"));
+		return false;
+	}
+	USoundSubmix* TargetSubmix = Submix ? Submix : &AudioDevice->GetMainSubmixObject();
+
+	const int32 NumOutputs = FJackClientManager::Get().GetNumOutputChannels();
+	TArray<int32> Map = ChannelMap;
+	if (Map.Num() == 0)
+	{
+		// Identity over every output port; submix channels that do not exist are skipped per buffer
+		for (int32 i = 0; i < NumOutputs; ++i)
+		{
+			Map.Add(i);
+		}
+	}
+	for (const int32 Output : Map)
+	{
+		if (Output >= NumOutputs)
+		{
+			UE_LOG(LogJackAudioLink, Warning, TEXT("StartSubmixOutput: channel map targets output %d but only %d are registered"), Output, NumOutputs);
+			return false;
+		}
+	}
+	const UJackAudioLinkSettings* Settings = GetDefault<UJackAudioLinkSettings>();
+	SubmixOutputBridge = MakeShared<FJackSubmixOutputBridge, ESPMode::ThreadSafe>(Map,
+		Settings->bCompensateClockDrift, Settings->DriftLoopBandwidthHz, Settings->MaxDriftCorrectionPpm);
+	// The bridge becomes the only writer of its outputs; game-thread writes to them are refused until Stop
+	TArray<int32> Owned = Map.FilterByPredicate([](int32 Output) { return Output >= 0; });
+	if (!FJackClientManager::Get().ClaimChannels(false, Owned, SubmixOutputBridge.Get()))
+	{
+		SubmixOutputBridge.Reset();
+		return false;
+	}
+	SubmixOutputSubmix = TargetSubmix;
+	AudioDevice->RegisterSubmixBufferListener(SubmixOutputBridge.ToSharedRef(), *TargetSubmix);
+	UE_LOG(LogJackAudioLink, Log, TEXT("Submix %s now streams to JACK"), *TargetSubmix->GetName());
+	return true;
+#else
+	return false;
+#endif
+}
+
+void UUEJackAudioLinkSubsystem::StopSubmixOutput()
+{
+	if (!SubmixOutputBridge.IsValid())
+	{
+		return;
+	}
+	if (GEngine)
+	{
+		FAudioDeviceHandle AudioDevice = GEngine->GetMainAudioDevice();
+		USoundSubmix* Submix = SubmixOutputSubmix.Get();
+		if (AudioDevice.IsValid() && Submix)
+		{
+			AudioDevice->UnregisterSubmixBufferListener(SubmixOutputBridge.ToSharedRef(), *Submix);
+		}
+	}
+	FJackClientManager::Get().ReleaseChannels(false, SubmixOutputBridge.Get());
+	SubmixOutputBridge.Reset();
+	SubmixOutputSubmix.Reset();
+}
+
+float UUEJackAudioLinkSubsystem::GetSubmixOutputDriftPpm() const
+{
+	return SubmixOutputBridge.IsValid() ? SubmixOutputBridge->GetDriftCorrectionPpm() : 0.0f;
+}
+
+int64 UUEJackAudioLinkSubsystem::GetAudioBufferAllocationCount() const
+{
+#if WITH_JACK
+	return static_cast<int64>(FJackClientManager::Get().GetAudioBufferAllocationCount());
+#else
+	return 0;
+#endif
+}
+
 float UUEJackAudioLinkSubsystem::GetInputLevel(int32 ChannelIndex) const
 {
 #if WITH_JACK
@@ -106,6 +337,101 @@ float UUEJackAudioLinkSubsystem::GetInputLevel(int32 ChannelIndex) const
 	return 0.0f;
 }
 
+float UUEJackAudioLinkSubsystem::GetInputPeakLevel(int32 ChannelIndex) const
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().GetInputPeakLevel(ChannelIndex);
+	}
+#endif
+	return 0.0f;
+}
+
+FJackAudioRingRegion UUEJackAudioLinkSubsystem::PeekInputBuffer(int32 ChannelIndex, int32 MaxSamples)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().PeekInputBuffer(ChannelIndex, MaxSamples);
+	}
+#endif
+	return FJackAudioRingRegion();
+}
+
+void UUEJackAudioLinkSubsystem::CommitInputBuffer(int32 ChannelIndex, int32 NumSamples)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		FJackClientManager::Get().CommitInputBuffer(ChannelIndex, NumSamples);
+	}
+#endif
+}
+
+FJackAudioRingRegion UUEJackAudioLinkSubsystem::PeekOutputBuffer(int32 ChannelIndex, int32 MaxSamples)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().PeekOutputBuffer(ChannelIndex, MaxSamples);
+	}
+#endif
+	return FJackAudioRingRegion();
+}
+
+void UUEJackAudioLinkSubsystem::CommitOutputBuffer(int32 ChannelIndex, int32 NumSamples)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		FJackClientManager::Get().CommitOutputBuffer(ChannelIndex, NumSamples);
+	}
+#endif
+}
+
+FJackAudioRingRegion UUEJackAudioLinkSubsystem::PeekInputFrames(int32 MaxFrames)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().PeekInputFrames(MaxFrames);
+	}
+#endif
+	return FJackAudioRingRegion();
+}
+
+void UUEJackAudioLinkSubsystem::CommitInputFrames(int32 NumFrames)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		FJackClientManager::Get().CommitInputFrames(NumFrames);
+	}
+#endif
+}
+
+FJackAudioRingRegion UUEJackAudioLinkSubsystem::PeekOutputFrames(int32 MaxFrames)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		return FJackClientManager::Get().PeekOutputFrames(MaxFrames);
+	}
+#endif
+	return FJackAudioRingRegion();
+}
+
+void UUEJackAudioLinkSubsystem::CommitOutputFrames(int32 NumFrames)
+{
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		FJackClientManager::Get().CommitOutputFrames(NumFrames);
+	}
+#endif
+}
+
 int32 UUEJackAudioLinkSubsystem::GetSampleRate() const
 {
 #if WITH_JACK
@@ -133,6 +459,122 @@ float UUEJackAudioLinkSubsystem::GetCpuLoad() const
 #endif
 }
 
+void UUEJackAudioLinkSubsystem::GetActivePortCounts(int32& ActivePorts, int32& RegisteredPorts) const
+{
+	ActivePorts = 0;
+	RegisteredPorts = 0;
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		ActivePorts = FJackClientManager::Get().GetActivePortCount();
+		RegisteredPorts = FJackClientManager::Get().GetRegisteredPortCount();
+	}
+#endif
+}
+
+FJackCallbackTimingStats UUEJackAudioLinkSubsystem::GetCallbackTimingStats() const
+{
+	FJackCallbackTimingStats Stats;
+#if WITH_JACK
+	const FJackCallbackTimingSnapshot Snapshot = FJackClientManager::Get().GetCallbackTiming();
+	Stats.NumCycles = static_cast<int64>(Snapshot.NumCycles);
+	Stats.MinMicroseconds = static_cast<float>(Snapshot.MinNs / 1000.0);
+	Stats.MeanMicroseconds = static_cast<float>(Snapshot.MeanNs / 1000.0);
+	Stats.P99Microseconds = static_cast<float>(Snapshot.P99Ns / 1000.0);
+	Stats.MaxMicroseconds = static_cast<float>(Snapshot.MaxNs / 1000.0);
+	Stats.MeanBudgetPercent = Snapshot.MeanBudgetFraction * 100.0f;
+	Stats.MaxBudgetPercent = Snapshot.MaxBudgetFraction * 100.0f;
+	Stats.CyclesOverBudgetThreshold = static_cast<int64>(Snapshot.NumCyclesOverThreshold);
+	Stats.BudgetThresholdPercent = Snapshot.BudgetThreshold * 100.0f;
+#endif
+	return Stats;
+}
+
+void UUEJackAudioLinkSubsystem::ResetCallbackTimingStats()
+{
+#if WITH_JACK
+	FJackClientManager::Get().ResetCallbackTiming();
+#endif
+}
+
+bool UUEJackAudioLinkSubsystem::GetChannelLatency(EJackPortDirection Direction, int32 ChannelIndex, FJackChannelLatency& OutLatency) const
+{
+	OutLatency = FJackChannelLatency();
+#if WITH_JACK
+	if (IsClientConnected())
+	{
+		FJackPortLatency Latency;
+		if (FJackClientManager::Get().GetPortLatency(Direction == EJackPortDirection::Input, ChannelIndex, Latency))
+		{
+			const float MillisecondsPerFrame = 1000.0f / FMath::Max<uint32>(FJackClientManager::Get().GetSampleRate(), 1);
+			OutLatency.JackMinFrames = Latency.JackMinFrames;
+			OutLatency.JackMaxFrames = Latency.JackMaxFrames;
+			OutLatency.RingFrames = Latency.RingFrames;
+			OutLatency.MinFrames = Latency.JackMinFrames + Latency.RingFrames;
+			OutLatency.MaxFrames = Latency.JackMaxFrames + Latency.RingFrames;
+			OutLatency.MinMilliseconds = OutLatency.MinFrames * MillisecondsPerFrame;
+			OutLatency.MaxMilliseconds = OutLatency.MaxFrames * MillisecondsPerFrame;
+			return true;
+		}
+	}
+#endif
+	return false;
+}
+
+int64 UUEJackAudioLinkSubsystem::GetXrunCount() const
+{
+#if WITH_JACK
+	return static_cast<int64>(FJackClientManager::Get().GetXrunCount());
+#else
+	return 0;
+#endif
+}
+
+float UUEJackAudioLinkSubsystem::GetXrunRate(float WindowSeconds) const
+{
+	if (WindowSeconds <= 0.0f)
+	{
+		return 0.0f;
+	}
+	const double WindowStart = FPlatformTime::Seconds() - WindowSeconds;
+	int32 NumInWindow = 0;
+	for (int32 i = RecentXruns.Num() - 1; i >= 0 && RecentXruns[i].PlatformSeconds >= WindowStart; --i)
+	{
+		++NumInWindow;
+	}
+	return NumInWindow * 60.0f / WindowSeconds;
+}
+
+bool UUEJackAudioLinkSubsystem::TickXruns(float DeltaTime)
+{
+#if WITH_JACK
+	static constexpr int32 MaxRecentXruns = 128;
+	FJackXrunEvent Event;
+	while (FJackClientManager::Get().DequeueXrunEvent(Event))
+	{
+		FJackXrunInfo Info;
+		Info.SequenceNumber = static_cast<int64>(Event.SequenceNumber);
+		Info.PlatformSeconds = Event.PlatformSeconds;
+		Info.DelayedMicroseconds = Event.DelayedMicroseconds;
+		Info.JackFrameTime = Event.FrameTime;
+		Info.LastCallbackMicroseconds = Event.LastCallbackNs / 1000.0f;
+		Info.LastCallbackBudgetPercent = Event.LastCallbackBudgetFraction * 100.0f;
+		Info.InputRingFill = Event.InputRingFill;
+		Info.OutputRingFill = Event.OutputRingFill;
+		Info.GameFrameNumber = static_cast<int64>(GFrameCounter);
+		Info.GameDeltaSeconds = DeltaTime;
+
+		if (RecentXruns.Num() >= MaxRecentXruns)
+		{
+			RecentXruns.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+		RecentXruns.Add(Info);
+		OnJackXrun.Broadcast(Info);
+	}
+#endif
+	return true;
+}
+
 TArray<FString> UUEJackAudioLinkSubsystem::GetConnectedClients() const
 {
 	return FJackClientManager::Get().GetAllClients();
@@ -173,26 +615,30 @@ static FString GetPortByIndexHelper(const FString& ClientName, int32 Number1Base
 {
 #if WITH_JACK
 	const auto& Mgr = FJackClientManager::Get();
-	TArray<FString> Ports = bWantInput ? Mgr.GetClientInputPorts(ClientName) : Mgr.GetClientOutputPorts(ClientName);
 	// Be forgiving: if 0 is provided, treat it as 1 (first port)
 	const int32 ClampedIndex = (Number1Based <= 0) ? 1 : Number1Based;
-	if (ClampedIndex >= 1 && ClampedIndex <= Ports.Num())
+	const FString Port = Mgr.GetClientPort(ClientName, bWantInput, ClampedIndex - 1);
+	if (!Port.IsEmpty())
 	{
-		return Ports[ClampedIndex - 1];
+		return Port;
 	}
 	UE_LOG(LogJackAudioLink, Warning, TEXT("GetPortByIndexHelper: Port Number out of range. Client=%s, WantInput=%s, RequestedNumber=%d, Available=%d"),
-		*ClientName, bWantInput ? TEXT("true") : TEXT("false"), Number1Based, Ports.Num());
+		*ClientName, bWantInput ? TEXT("true") : TEXT("false"), Number1Based, Mgr.GetNumClientPorts(ClientName, bWantInput));
 #endif
 	return FString();
 }
 
-bool UUEJackAudioLinkSubsystem::ConnectPortsByIndex(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
-													EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber)
+// Body of (Dis)ConnectPortsByIndex and their async variants. Resolves through the graph index, so it is
+// safe on the control thread.
+static bool RoutePortsByIndex(bool bConnect, EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+							  EJackPortDirection DestType, const FString& DestClientName, int32 DestPortNumber)
 {
+	const TCHAR* Caller = bConnect ? TEXT("ConnectPortsByIndex") : TEXT("DisconnectPortsByIndex");
 	// Validate directions: JACK requires Source=Output, Dest=Input
 	if (SourceType != EJackPortDirection::Output || DestType != EJackPortDirection::Input)
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("ConnectPortsByIndex: Invalid directions (Source must be Output, Dest must be Input). Requested: SrcType=%s, DstType=%s, SrcClient=%s Port#=%d, DstClient=%s Port#=%d"),
+		UE_LOG(LogJackAudioLink, Warning, TEXT("%s: Invalid directions (Source must be Output, Dest must be Input). Requested: SrcType=%s, DstType=%s, SrcClient=%s Port#=%d, DstClient=%s Port#=%d"),
+			Caller,
 			SourceType == EJackPortDirection::Output ? TEXT("Output") : TEXT("Input"),
 			DestType   == EJackPortDirection::Input  ? TEXT("Input")  : TEXT("Output"),
 			*SourceClientName, SourcePortNumber, *DestClientName, DestPortNumber);
@@ -203,45 +649,152 @@ bool UUEJackAudioLinkSubsystem::ConnectPortsByIndex(EJackPortDirection SourceTyp
 	const FString DestPort   = GetPortByIndexHelper(DestClientName,   DestPortNumber,   /*bWantInput*/ true);
 	if (SourcePort.IsEmpty() || DestPort.IsEmpty())
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("ConnectPortsByIndex: Failed to resolve port names. SrcClient=%s Port#=%d -> '%s' ; DstClient=%s Port#=%d -> '%s'"),
-			*SourceClientName, SourcePortNumber, *SourcePort, *DestClientName, DestPortNumber, *DestPort);
+		UE_LOG(LogJackAudioLink, Warning, TEXT("%s: Failed to resolve port names. SrcClient=%s Port#=%d -> '%s' ; DstClient=%s Port#=%d -> '%s'"),
+			Caller, *SourceClientName, SourcePortNumber, *SourcePort, *DestClientName, DestPortNumber, *DestPort);
 		return false;
 	}
-	UE_LOG(LogJackAudioLink, Display, TEXT("ConnectPortsByIndex: Connecting '%s' -> '%s'"), *SourcePort, *DestPort);
-	const bool bOK = ConnectPorts(SourcePort, DestPort);
+	UE_LOG(LogJackAudioLink, Display, TEXT("%s: %s '%s' -> '%s'"), Caller, bConnect ? TEXT("Connecting") : TEXT("Disconnecting"), *SourcePort, *DestPort);
+	FJackClientManager& Mgr = FJackClientManager::Get();
+	const bool bOK = bConnect ? Mgr.ConnectPorts(SourcePort, DestPort) : Mgr.DisconnectPorts(SourcePort, DestPort);
 	if (!bOK)
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("ConnectPortsByIndex: jack_connect failed for '%s' -> '%s'"), *SourcePort, *DestPort);
+		UE_LOG(LogJackAudioLink, Warning, TEXT("%s: %s failed for '%s' -> '%s'"), Caller, bConnect ? TEXT("jack_connect") : TEXT("jack_disconnect"), *SourcePort, *DestPort);
 	}
 	return bOK;
 }
 
+bool UUEJackAudioLinkSubsystem::ConnectPortsByIndex(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+													EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber)
+{
+	return RoutePortsByIndex(true, SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+}
+
 bool UUEJackAudioLinkSubsystem::DisconnectPortsByIndex(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
 													   EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber)
 {
-	if (SourceType != EJackPortDirection::Output || DestType != EJackPortDirection::Input)
+	return RoutePortsByIndex(false, SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+}
+
+TFuture<bool> UUEJackAudioLinkSubsystem::ConnectPortsAsync(const FString& SourcePort, const FString& DestinationPort)
+{
+	return FJackClientManager::Get().ConnectPortsAsync(SourcePort, DestinationPort);
+}
+
+TFuture<bool> UUEJackAudioLinkSubsystem::DisconnectPortsAsync(const FString& SourcePort, const FString& DestinationPort)
+{
+	return FJackClientManager::Get().DisconnectPortsAsync(SourcePort, DestinationPort);
+}
+
+TFuture<bool> UUEJackAudioLinkSubsystem::ConnectPortsByIndexAsync(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+																 EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber)
+{
+	return FJackClientManager::Get().RunOnControlThread<bool>([SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber]()
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("DisconnectPortsByIndex: Invalid directions (Source must be Output, Dest must be Input). Requested: SrcType=%s, DstType=%s, SrcClient=%s Port#=%d, DstClient=%s Port#=%d"),
-			SourceType == EJackPortDirection::Output ? TEXT("Output") : TEXT("Input"),
-			DestType   == EJackPortDirection::Input  ? TEXT("Input")  : TEXT("Output"),
-			*SourceClientName, SourcePortNumber, *DestClientName, DestPortNumber);
-		return false;
+		return RoutePortsByIndex(true, SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+	});
+}
+
+TFuture<bool> UUEJackAudioLinkSubsystem::DisconnectPortsByIndexAsync(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+																	EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber)
+{
+	return FJackClientManager::Get().RunOnControlThread<bool>([SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber]()
+	{
+		return RoutePortsByIndex(false, SourceType, SourceClientName, SourcePortNumber, DestType, DestClientName, DestPortNumber);
+	});
+}
+
+TFuture<TArray<FString>> UUEJackAudioLinkSubsystem::GetConnectedClientsAsync()
+{
+	return FJackClientManager::Get().RunOnControlThread<TArray<FString>>([]()
+	{
+		return FJackClientManager::Get().GetAllClients();
+	});
+}
+
+TFuture<FJackClientPorts> UUEJackAudioLinkSubsystem::GetClientPortsAsync(const FString& ClientName)
+{
+	return FJackClientManager::Get().RunOnControlThread<FJackClientPorts>([ClientName]()
+	{
+		FJackClientPorts Ports;
+		Ports.InputPorts = FJackClientManager::Get().GetClientInputPorts(ClientName);
+		Ports.OutputPorts = FJackClientManager::Get().GetClientOutputPorts(ClientName);
+		return Ports;
+	});
+}
+
+void UUEJackAudioLinkSubsystem::ApplyRoutingMatrix(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope, const FOnJackRoutingApplied& OnComplete)
+{
+	ApplyRoutingMatrix(TArray<FJackRoutingEdge>(Edges), Scope).Next([OnComplete](FJackRoutingResult Result)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, Result = MoveTemp(Result)]()
+		{
+			OnComplete.ExecuteIfBound(Result);
+		});
+	});
+}
+
+TFuture<FJackRoutingResult> UUEJackAudioLinkSubsystem::ApplyRoutingMatrix(TArray<FJackRoutingEdge> Edges, EJackRoutingScope Scope)
+{
+	return FJackClientManager::Get().ApplyRoutingMatrix(MoveTemp(Edges), Scope);
+}
+
+FJackRoutingEdge UUEJackAudioLinkSubsystem::MakeRoutingEdgeByIndex(const FString& SourceClientName, int32 SourcePortNumber, const FString& DestClientName, int32 DestPortNumber) const
+{
+	const FJackClientManager& Mgr = FJackClientManager::Get();
+	// Same forgiveness as ConnectPortsByIndex: 0 means the first port
+	return FJackRoutingEdge(
+		Mgr.GetClientPort(SourceClientName, /*bInput*/ false, FMath::Max(SourcePortNumber, 1) - 1),
+		Mgr.GetClientPort(DestClientName, /*bInput*/ true, FMath::Max(DestPortNumber, 1) - 1));
+}
+
+UJackRoutingPreset* UUEJackAudioLinkSubsystem::CaptureRoutingPreset(FName PresetName)
+{
+	UJackRoutingPreset* Preset = NewObject<UJackRoutingPreset>(this);
+	Preset->Connections = FJackClientManager::Get().GetAllConnections();
+	if (!PresetName.IsNone())
+	{
+		RoutingPresets.Add(PresetName, Preset);
 	}
-	const FString SourcePort = GetPortByIndexHelper(SourceClientName, SourcePortNumber, /*bWantInput*/ false);
-	const FString DestPort   = GetPortByIndexHelper(DestClientName,   DestPortNumber,   /*bWantInput*/ true);
-	if (SourcePort.IsEmpty() || DestPort.IsEmpty())
+	UE_LOG(LogJackAudioLink, Log, TEXT("Captured routing preset '%s': %d connections"), *PresetName.ToString(), Preset->Connections.Num());
+	return Preset;
+}
+
+void UUEJackAudioLinkSubsystem::CaptureRoutingPresetInto(UJackRoutingPreset* Preset)
+{
+	if (!Preset)
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("DisconnectPortsByIndex: Failed to resolve port names. SrcClient=%s Port#=%d -> '%s' ; DstClient=%s Port#=%d -> '%s'"),
-			*SourceClientName, SourcePortNumber, *SourcePort, *DestClientName, DestPortNumber, *DestPort);
-		return false;
+		return;
 	}
-	UE_LOG(LogJackAudioLink, Display, TEXT("DisconnectPortsByIndex: Disconnecting '%s' -> '%s'"), *SourcePort, *DestPort);
-	const bool bOK = DisconnectPorts(SourcePort, DestPort);
-	if (!bOK)
+	Preset->Modify();
+	Preset->Connections = FJackClientManager::Get().GetAllConnections();
+	Preset->MarkPackageDirty();
+}
+
+UJackRoutingPreset* UUEJackAudioLinkSubsystem::FindRoutingPreset(FName PresetName) const
+{
+	const TObjectPtr<UJackRoutingPreset>* Preset = RoutingPresets.Find(PresetName);
+	return Preset ? Preset->Get() : nullptr;
+}
+
+void UUEJackAudioLinkSubsystem::RestoreRoutingPreset(UJackRoutingPreset* Preset, const FOnJackRoutingApplied& OnComplete)
+{
+	RestoreRoutingPreset(static_cast<const UJackRoutingPreset*>(Preset)).Next([OnComplete](FJackRoutingResult Result)
 	{
-		UE_LOG(LogJackAudioLink, Warning, TEXT("DisconnectPortsByIndex: jack_disconnect failed for '%s' -> '%s'"), *SourcePort, *DestPort);
+		AsyncTask(ENamedThreads::GameThread, [OnComplete, Result = MoveTemp(Result)]()
+		{
+			OnComplete.ExecuteIfBound(Result);
+		});
+	});
+}
+
+TFuture<FJackRoutingResult> UUEJackAudioLinkSubsystem::RestoreRoutingPreset(const UJackRoutingPreset* Preset)
+{
+	if (!Preset)
+	{
+		UE_LOG(LogJackAudioLink, Warning, TEXT("RestoreRoutingPreset: no preset given"));
+		return MakeFulfilledPromise<FJackRoutingResult>().GetFuture();
 	}
-	return bOK;
+	return FJackClientManager::Get().ApplyRoutingMatrix(Preset->Connections, Preset->RestoreScope);
 }
 
 FString UUEJackAudioLinkSubsystem::GetJackClientName() const
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "UEJackAudioLinkSubsystem.h"
+#include "JackAudioLinkAsyncActions.generated.h"
+
+class UJackRoutingPreset;
+
+// Blueprint async nodes over the subsystem's async routing and discovery calls. The JACK work runs on the
+// client's control thread; the output pins fire on the game thread once it is done, so routing-heavy graphs
+// do not stall the frame.
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FJackAsyncActionDone);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FJackRoutingMatrixAsyncDone, const FJackRoutingResult&, Result);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FJackClientsAsyncDone, const TArray<FString>&, Clients);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FJackClientPortsAsyncDone, const TArray<FString>&, InputPorts, const TArray<FString>&, OutputPorts);
+
+// Connect or disconnect one pair of ports
+UCLASS()
+class UEJACKAUDIOLINK_API UJackRoutingAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Connect Ports (Async)"))
+	static UJackRoutingAsyncAction* ConnectPortsAsync(UObject* WorldContextObject, const FString& SourcePort, const FString& DestinationPort);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Disconnect Ports (Async)"))
+	static UJackRoutingAsyncAction* DisconnectPortsAsync(UObject* WorldContextObject, const FString& SourcePort, const FString& DestinationPort);
+
+	// Port numbers are 1-based, as in ConnectPortsByIndex
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Connect Ports By Index (Async)"))
+	static UJackRoutingAsyncAction* ConnectPortsByIndexAsync(UObject* WorldContextObject, EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+															 EJackPortDirection DestType, const FString& DestClientName, int32 DestPortNumber);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Disconnect Ports By Index (Async)"))
+	static UJackRoutingAsyncAction* DisconnectPortsByIndexAsync(UObject* WorldContextObject, EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+																EJackPortDirection DestType, const FString& DestClientName, int32 DestPortNumber);
+
+	UPROPERTY(BlueprintAssignable)
+	FJackAsyncActionDone OnSuccess;
+
+	UPROPERTY(BlueprintAssignable)
+	FJackAsyncActionDone OnFailure;
+
+	virtual void Activate() override;
+	void Complete(bool bSucceeded);
+
+private:
+	TFunction<TFuture<bool>(UUEJackAudioLinkSubsystem&)> Start;
+};
+
+// Apply a routing matrix or restore a routing preset
+UCLASS()
+class UEJACKAUDIOLINK_API UJackRoutingMatrixAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Apply Routing Matrix (Async)"))
+	static UJackRoutingMatrixAsyncAction* ApplyRoutingMatrixAsync(UObject* WorldContextObject, const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Restore Routing Preset (Async)"))
+	static UJackRoutingMatrixAsyncAction* RestoreRoutingPresetAsync(UObject* WorldContextObject, UJackRoutingPreset* Preset);
+
+	// Every edge ended Unchanged, Connected or Disconnected
+	UPROPERTY(BlueprintAssignable)
+	FJackRoutingMatrixAsyncDone OnCompleted;
+
+	// Some edges failed (see Result.Edges)
+	UPROPERTY(BlueprintAssignable)
+	FJackRoutingMatrixAsyncDone OnFailed;
+
+	virtual void Activate() override;
+	void Complete(const FJackRoutingResult& Result);
+
+private:
+	TFunction<TFuture<FJackRoutingResult>(UUEJackAudioLinkSubsystem&)> Start;
+};
+
+UCLASS()
+class UEJACKAUDIOLINK_API UJackGetClientsAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Discovery", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Get Connected Clients (Async)"))
+	static UJackGetClientsAsyncAction* GetConnectedClientsAsync(UObject* WorldContextObject);
+
+	UPROPERTY(BlueprintAssignable)
+	FJackClientsAsyncDone OnCompleted;
+
+	virtual void Activate() override;
+	void Complete(const TArray<FString>& Clients);
+};
+
+UCLASS()
+class UEJACKAUDIOLINK_API UJackGetClientPortsAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Discovery", meta=(BlueprintInternalUseOnly="true", WorldContext="WorldContextObject", DisplayName="Get Client Ports (Async)"))
+	static UJackGetClientPortsAsyncAction* GetClientPortsAsync(UObject* WorldContextObject, const FString& ClientName);
+
+	UPROPERTY(BlueprintAssignable)
+	FJackClientPortsAsyncDone OnCompleted;
+
+	virtual void Activate() override;
+	void Complete(const FJackClientPorts& Ports);
+
+private:
+	FString QueryClientName;
+};
@@ -66,6 +66,50 @@ public:
     UPROPERTY(EditAnywhere, Config, Category="Client", meta=(ClampMin="1", UIMin="1"))
     int32 OutputChannels = 64;
 
+    /** Store all inputs (and, separately, all outputs) in one frame-interleaved ring with a single cursor.
+     *  Keeps channels sample-aligned and cheapens the process callback for high channel counts, but
+     *  per-channel Read/WriteAudioBuffer are then unavailable; use Read/WriteAudioFrames instead. */
+    UPROPERTY(EditAnywhere, Config, Category="Client")
+    bool bUseMultichannelRing = false;
+
+    // Metering
+    /** Integration window of the input RMS meters (ms) */
+    UPROPERTY(EditAnywhere, Config, Category="Metering", meta=(ClampMin="1", UIMin="10", UIMax="3000"))
+    float MeterIntegrationWindowMs = 300.0f;
+
+    /** Fall rate of the held input peak (dB per second) */
+    UPROPERTY(EditAnywhere, Config, Category="Metering", meta=(ClampMin="0", UIMin="0", UIMax="120"))
+    float MeterPeakDecayDbPerSecond = 20.0f;
+
+    /** Share of the cycle period (BufferSize / SampleRate) above which a process callback counts as over budget (%) */
+    UPROPERTY(EditAnywhere, Config, Category="Metering", meta=(ClampMin="1", ClampMax="100", UIMin="10", UIMax="100"))
+    float CallbackBudgetThresholdPercent = 80.0f;
+
+    // Sample rate conversion
+    /** Rate of the audio game code reads from the input rings (Hz). The process callback converts from the
+     *  JACK rate with a polyphase filter. 0 keeps the inputs at the JACK rate */
+    UPROPERTY(EditAnywhere, Config, Category="Sample Rate Conversion", meta=(ClampMin="0", ClampMax="384000", UIMin="0", UIMax="192000"))
+    int32 InputRingSampleRate = 0;
+
+    /** Rate of the audio game code writes to the output rings (Hz), converted to the JACK rate in the process
+     *  callback. 0 keeps the outputs at the JACK rate */
+    UPROPERTY(EditAnywhere, Config, Category="Sample Rate Conversion", meta=(ClampMin="0", ClampMax="384000", UIMin="0", UIMax="192000"))
+    int32 OutputRingSampleRate = 0;
+
+    // Clock drift
+    /** Resample at the UE end of the rings fed from UE's audio render thread (submix output, input synth
+     *  components) so their fill, and so the latency, stays constant while the two clocks drift apart */
+    UPROPERTY(EditAnywhere, Config, Category="Clock Drift")
+    bool bCompensateClockDrift = true;
+
+    /** How fast the drift estimate follows the ring fill (Hz); lower averages more scheduling jitter */
+    UPROPERTY(EditAnywhere, Config, Category="Clock Drift", meta=(ClampMin="0.001", ClampMax="1", UIMin="0.005", UIMax="0.2", EditCondition="bCompensateClockDrift"))
+    float DriftLoopBandwidthHz = 0.02f;
+
+    /** Largest correction applied on top of the nominal rate ratio (ppm). 1000 ppm is under 2 cents of pitch */
+    UPROPERTY(EditAnywhere, Config, Category="Clock Drift", meta=(ClampMin="1", ClampMax="10000", UIMin="100", UIMax="5000", EditCondition="bCompensateClockDrift"))
+    float MaxDriftCorrectionPpm = 1000.0f;
+
     // (Auto-connect and extra server options removed for simplicity)
 
     #if WITH_EDITOR
@@ -75,4 +119,10 @@ public:
 public:
     int32 GetSampleRateValue() const;
     int32 GetBufferSizeValue() const;
+
+    /** Pushes the metering and callback budget settings to the JACK client */
+    void ApplyMeteringSettings() const;
+
+    /** Pushes the per-direction ring sample rates to the JACK client (re-registers its ports when they change) */
+    void ApplySampleRateConversionSettings() const;
 }; 
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A readable or writable region of a JACK audio ring, exposed in place.
+ * Because the ring wraps, the region is split into at most two contiguous spans;
+ * Second is empty unless the region crosses the end of the ring storage.
+ * The views stay valid until the matching Commit call, and only while the ports are not re-registered.
+ */
+struct FJackAudioRingRegion
+{
+	TArrayView<float> First;
+	TArrayView<float> Second;
+
+	int32 Num() const { return First.Num() + Second.Num(); }
+	bool IsEmpty() const { return Num() == 0; }
+};
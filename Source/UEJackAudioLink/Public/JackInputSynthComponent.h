@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SynthComponent.h"
+#include <atomic>
+#include "JackInputSynthComponent.generated.h"
+
+struct FJackInputDriftState;
+struct FJackPortSet;
+
+// Plays JACK inputs as a regular UE sound source: OnGenerateAudio pulls straight from the input rings on the
+// audio render thread, so live inputs can be spatialized and mixed with one render block of latency and no
+// game-thread copies. From Init until it stops generating or is unregistered, the component claims its channels
+// as their only consumer and game-thread reads of them are refused (with the multichannel ring, of every input).
+// With clock drift compensation on (project settings), the rings are read through a variable-ratio resampler
+// steered by their fill, so the JACK clock drifting against the mixer's neither starves nor backs up the source.
+UCLASS(ClassGroup=(JackAudioLink), meta=(BlueprintSpawnableComponent))
+class UEJACKAUDIOLINK_API UJackInputSynthComponent : public USynthComponent
+{
+	GENERATED_BODY()
+
+public:
+	UJackInputSynthComponent(const FObjectInitializer& ObjectInitializer);
+
+	// JACK input channels (0-based) rendered as this source's channels, in order (1 to 8); empty plays input 0 in mono
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="JackAudioLink")
+	TArray<int32> InputChannels;
+
+	// Buffered input kept when playback starts; older audio is dropped so the source starts at minimal latency
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="JackAudioLink", meta=(ClampMin="0"))
+	int32 MaxStartupBacklogFrames = 0;
+
+	// Drift correction currently applied to the input rate (ppm); 0 without drift compensation
+	UFUNCTION(BlueprintPure, Category="JackAudioLink")
+	float GetDriftCorrectionPpm() const { return DriftCorrectionPpm.load(std::memory_order_relaxed); }
+
+protected:
+	//~ Begin USynthComponent
+	virtual bool Init(int32& SampleRate) override;
+	virtual int32 OnGenerateAudio(float* OutAudio, int32 NumSamples) override;
+	virtual void OnEndGenerate() override;
+	//~ End USynthComponent
+
+	//~ Begin UActorComponent
+	virtual void OnUnregister() override;
+	//~ End UActorComponent
+
+private:
+	// Copy of InputChannels taken in Init; read-only on the render thread afterwards
+	TArray<int32> RenderChannels;
+	int32 RenderSampleRate = 0;
+	// Resampler and loop state, created in Init when drift compensation is on; owned by the render thread afterwards
+	TSharedPtr<FJackInputDriftState> DriftState;
+	// Port set the render thread reads from, refreshed when the client's generation changes
+	TSharedPtr<const FJackPortSet> PortSet;
+	uint32 PortSetGeneration = 0;
+	std::atomic<bool> bTrimBacklog{false};
+	std::atomic<float> DriftCorrectionPpm{0.0f};
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Lets another module render audio inside the JACK process callback, e.g. the UEJackAudioMixer backend
+class IJackProcessHook
+{
+public:
+	virtual ~IJackProcessHook() = default;
+
+	// JACK process thread, once per cycle after the rings have been serviced. OutputBuffers[c] is this cycle's
+	// buffer of output port c (nullptr when unconnected) and already holds the audio written through the
+	// output rings, so mix into it. Called with NumOutputs == 0 while no ports are registered.
+	// SampleRate is the server's current rate.
+	virtual void OnJackProcess(float* const* OutputBuffers, int32 NumOutputs, int32 NumFrames, uint32 SampleRate) = 0;
+};
+
+class UEJACKAUDIOLINK_API FJackProcessHooks
+{
+public:
+	// Installs Hook (nullptr removes it); one hook at a time. Returns once the process callback
+	// is no longer inside the previous hook, so it can be destroyed right after.
+	static void SetHook(IJackProcessHook* Hook);
+
+	// Format of the connected client; false while not connected
+	static bool GetStreamFormat(uint32& OutSampleRate, uint32& OutBufferSize, int32& OutNumOutputs);
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "JackRoutingTypes.h"
+#include "JackRoutingPreset.generated.h"
+
+// A saved JACK patch: the audio connections of the graph at capture time, by full port name. Create one as a
+// Data Asset and fill it with UUEJackAudioLinkSubsystem::CaptureRoutingPresetInto, or capture a transient one
+// at runtime; RestoreRoutingPreset brings the graph back to it, touching only the connections that differ.
+UCLASS(BlueprintType)
+class UEJACKAUDIOLINK_API UJackRoutingPreset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Output -> input connections
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="JackAudioLink|Routing")
+	TArray<FJackRoutingEdge> Connections;
+
+	// What restoring does with connections the preset does not list; Whole Graph reproduces the audio snapshot
+	// exactly. Only audio is captured and restored, so MIDI connections are left as they are.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="JackAudioLink|Routing")
+	EJackRoutingScope RestoreScope = EJackRoutingScope::WholeGraph;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JackRoutingTypes.generated.h"
+
+// Which existing connections a routing matrix apply may break
+UENUM(BlueprintType)
+enum class EJackRoutingScope : uint8
+{
+	AddOnly     UMETA(DisplayName="Add Only"),     // Only make the listed connections
+	ListedPorts UMETA(DisplayName="Listed Ports"), // Also break every other connection of a port the matrix lists
+	WholeGraph  UMETA(DisplayName="Whole Graph")   // Make the whole JACK audio graph exactly the matrix (MIDI is left alone)
+};
+
+UENUM(BlueprintType)
+enum class EJackRoutingEdgeResult : uint8
+{
+	Unchanged    UMETA(DisplayName="Unchanged"),    // Already in the wanted state; nothing was sent to JACK
+	Connected    UMETA(DisplayName="Connected"),
+	Disconnected UMETA(DisplayName="Disconnected"),
+	MissingPort  UMETA(DisplayName="Missing Port"), // A port of the edge does not exist
+	Failed       UMETA(DisplayName="Failed")        // JACK refused the (dis)connection
+};
+
+// One connection, output port -> input port, by full JACK name ("client:port")
+USTRUCT(BlueprintType)
+struct UEJACKAUDIOLINK_API FJackRoutingEdge
+{
+	GENERATED_BODY()
+
+	FJackRoutingEdge() = default;
+	FJackRoutingEdge(const FString& InSourcePort, const FString& InDestinationPort)
+		: SourcePort(InSourcePort), DestinationPort(InDestinationPort) {}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="JackAudioLink|Routing")
+	FString SourcePort;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="JackAudioLink|Routing")
+	FString DestinationPort;
+
+	bool operator==(const FJackRoutingEdge& Other) const
+	{
+		return SourcePort == Other.SourcePort && DestinationPort == Other.DestinationPort;
+	}
+	friend uint32 GetTypeHash(const FJackRoutingEdge& Edge)
+	{
+		return HashCombine(GetTypeHash(Edge.SourcePort), GetTypeHash(Edge.DestinationPort));
+	}
+};
+
+USTRUCT(BlueprintType)
+struct UEJACKAUDIOLINK_API FJackRoutingEdgeStatus
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	FJackRoutingEdge Edge;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	EJackRoutingEdgeResult Result = EJackRoutingEdgeResult::Unchanged;
+};
+
+// Outcome of a routing matrix apply: one entry per connection it broke, then one per wanted edge
+USTRUCT(BlueprintType)
+struct UEJACKAUDIOLINK_API FJackRoutingResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	TArray<FJackRoutingEdgeStatus> Edges;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	int32 NumConnected = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	int32 NumDisconnected = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	int32 NumUnchanged = 0;
+
+	// MissingPort + Failed
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	int32 NumFailed = 0;
+
+	// Time spent on the control thread, diff included
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Routing")
+	float Milliseconds = 0.0f;
+
+	void Add(const FJackRoutingEdge& Edge, EJackRoutingEdgeResult Result)
+	{
+		FJackRoutingEdgeStatus& Status = Edges.AddDefaulted_GetRef();
+		Status.Edge = Edge;
+		Status.Result = Result;
+		switch (Result)
+		{
+		case EJackRoutingEdgeResult::Unchanged:    ++NumUnchanged; break;
+		case EJackRoutingEdgeResult::Connected:    ++NumConnected; break;
+		case EJackRoutingEdgeResult::Disconnected: ++NumDisconnected; break;
+		default:                                   ++NumFailed; break;
+		}
+	}
+};
@@ -2,7 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
-#include "UEJackAudioLinkSubsystem.h" // for EJackPortDirection
+#include "UEJackAudioLinkSubsystem.h" // for EJackPortDirection, EJackAudioFrameLayout
 #include "UEJackAudioLinkBPLibrary.generated.h"
 
 UCLASS()
@@ -32,9 +32,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
 	static bool WriteAudioBuffer(int32 ChannelIndex, const TArray<float>& AudioData);
 
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static int32 ReadAudioBufferInto(int32 ChannelIndex, int32 NumSamples, UPARAM(ref) TArray<float>& Buffer);
+
+	// Batched frame I/O over a channel range or mask (see UUEJackAudioLinkSubsystem)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static int32 ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, UPARAM(ref) TArray<float>& Samples);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static int32 WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, const TArray<float>& Samples);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static int32 ReadAudioFramesMasked(int64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, UPARAM(ref) TArray<float>& Samples);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static int32 WriteAudioFramesMasked(int64 ChannelMask, EJackAudioFrameLayout Layout, const TArray<float>& Samples);
+
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
 	static float GetInputLevel(int32 ChannelIndex);
 
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
+	static float GetInputPeakLevel(int32 ChannelIndex);
+
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
 	static int32 GetSampleRate();
 
@@ -45,6 +64,39 @@ public:
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
 	static float GetCpuLoad();
 
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static void GetActivePortCounts(int32& ActivePorts, int32& RegisteredPorts);
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static int64 GetAudioBufferAllocationCount();
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static bool StartSubmixOutput(USoundSubmix* Submix, const TArray<int32>& ChannelMap);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	static void StopSubmixOutput();
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
+	static float GetSubmixOutputDriftPpm();
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static FJackCallbackTimingStats GetCallbackTimingStats();
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Info")
+	static void ResetCallbackTimingStats();
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Info")
+	static bool GetChannelLatency(EJackPortDirection Direction, int32 ChannelIndex, FJackChannelLatency& OutLatency);
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static int64 GetXrunCount();
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static float GetXrunRate(float WindowSeconds = 60.0f);
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	static TArray<FJackXrunInfo> GetRecentXruns();
+
 	// Discovery
 	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Discovery")
 	static TArray<FString> GetConnectedClients();
@@ -68,6 +120,26 @@ public:
 	static bool DisconnectPortsByIndex(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
 									   EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber);
 
+	// Routing matrix (see UUEJackAudioLinkSubsystem::ApplyRoutingMatrix)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(AutoCreateRefTerm="OnComplete"))
+	static void ApplyRoutingMatrix(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope, const FOnJackRoutingApplied& OnComplete);
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Routing")
+	static FJackRoutingEdge MakeRoutingEdgeByIndex(const FString& SourceClientName, int32 SourcePortNumber, const FString& DestClientName, int32 DestPortNumber);
+
+	// Routing presets (see UUEJackAudioLinkSubsystem)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing")
+	static UJackRoutingPreset* CaptureRoutingPreset(FName PresetName);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing")
+	static void CaptureRoutingPresetInto(UJackRoutingPreset* Preset);
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Routing")
+	static UJackRoutingPreset* FindRoutingPreset(FName PresetName);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(AutoCreateRefTerm="OnComplete"))
+	static void RestoreRoutingPreset(UJackRoutingPreset* Preset, const FOnJackRoutingApplied& OnComplete);
+
 	// Our Unreal JACK client name
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
 	static FString GetJackClientName();
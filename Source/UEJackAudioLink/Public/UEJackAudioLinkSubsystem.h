@@ -3,8 +3,15 @@
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "Containers/Ticker.h"
+#include "JackAudioRingRegion.h"
+#include "JackRoutingTypes.h"
+#include "Async/Future.h"
 #include "UEJackAudioLinkSubsystem.generated.h"
 
+class USoundSubmix;
+class UJackRoutingPreset;
+class FJackSubmixOutputBridge;
+
 UENUM(BlueprintType)
 enum class EJackPortDirection : uint8
 {
@@ -12,9 +19,137 @@ enum class EJackPortDirection : uint8
 	Output UMETA(DisplayName="Output")
 };
 
+UENUM(BlueprintType)
+enum class EJackAudioFrameLayout : uint8
+{
+	Interleaved UMETA(DisplayName="Interleaved"), // Frame-major: [Frame0 Ch0, Frame0 Ch1, ..., Frame1 Ch0, ...]
+	Planar      UMETA(DisplayName="Planar")       // Channel-major: [Ch0 Frame0..N-1, Ch1 Frame0..N-1, ...]
+};
+
+// Timing of this plugin's JACK process callback (see GetCallbackTimingStats)
+USTRUCT(BlueprintType)
+struct FJackCallbackTimingStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int64 NumCycles = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MinMicroseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MeanMicroseconds = 0.0f;
+
+	// From a log-bucket histogram, accurate to about 12%
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float P99Microseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MaxMicroseconds = 0.0f;
+
+	// Callback time as a percentage of the cycle period (BufferSize / SampleRate)
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MeanBudgetPercent = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MaxBudgetPercent = 0.0f;
+
+	// Cycles that used more than BudgetThresholdPercent of the period
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int64 CyclesOverBudgetThreshold = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float BudgetThresholdPercent = 0.0f;
+};
+
+// Latency of one channel: for inputs capture -> game (system capture to the sample the game reads next),
+// for outputs game -> playback (the sample the game writes now to the system output)
+USTRUCT(BlueprintType)
+struct FJackChannelLatency
+{
+	GENERATED_BODY()
+
+	// JACK graph latency range of our port (upstream capture latency for inputs, downstream playback latency for outputs)
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 JackMinFrames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 JackMaxFrames = 0;
+
+	// Samples currently buffered in the ring between JACK and the game
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 RingFrames = 0;
+
+	// JACK range plus ring buffering
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 MinFrames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 MaxFrames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MinMilliseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float MaxMilliseconds = 0.0f;
+};
+
+// One xrun, with our callback and ring state at the time and the game frame that picked it up
+USTRUCT(BlueprintType)
+struct FJackXrunInfo
+{
+	GENERATED_BODY()
+
+	// 1-based count of xruns since the client connected; gaps mean events were dropped while the game thread stalled
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int64 SequenceNumber = 0;
+
+	// FPlatformTime::Seconds() when JACK reported the xrun
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	double PlatformSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float DelayedMicroseconds = 0.0f;
+
+	// JACK frame time (jack_frame_time) at notification
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int64 JackFrameTime = 0;
+
+	// Duration and budget share of our process callback in the cycle before the xrun
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float LastCallbackMicroseconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float LastCallbackBudgetPercent = 0.0f;
+
+	// Readable samples (frames in multichannel ring mode) of the first input/output ring after that cycle
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 InputRingFill = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int32 OutputRingFill = 0;
+
+	// Game frame that received the event and its delta time, to spot game-thread hitches
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	int64 GameFrameNumber = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category="JackAudioLink|Info")
+	float GameDeltaSeconds = 0.0f;
+};
+
+// Audio ports of one client, for GetClientPortsAsync
+struct FJackClientPorts
+{
+	TArray<FString> InputPorts;
+	TArray<FString> OutputPorts;
+};
+
 // Blueprint event signatures
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnNewJackClientConnected, const FString&, ClientName, int32, NumInputPorts, int32, NumOutputPorts);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnJackClientDisconnected, const FString&, ClientName);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnJackXrun, const FJackXrunInfo&, Xrun);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnJackRoutingApplied, const FJackRoutingResult&, Result);
 
 UCLASS()
 class UEJACKAUDIOLINK_API UUEJackAudioLinkSubsystem : public UEngineSubsystem
@@ -44,9 +179,80 @@ public:
 	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
 	bool WriteAudioBuffer(int32 ChannelIndex, const TArray<float>& AudioData);
 
+	// Allocation-free read into a caller-owned array that is reused across calls (resized without shrinking).
+	// Returns the number of samples actually read; the rest of the buffer is zeroed.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	int32 ReadAudioBufferInto(int32 ChannelIndex, int32 NumSamples, UPARAM(ref) TArray<float>& Buffer);
+
+	// C++ allocation-free overloads
+	int32 ReadAudioBuffer(int32 ChannelIndex, TArrayView<float> OutSamples);
+	bool WriteAudioBuffer(int32 ChannelIndex, TConstArrayView<float> AudioData);
+
+	// Batched frame I/O: moves NumFrames for a contiguous channel range (0-based) in one call. All channels move
+	// the same number of frames, which is returned, so they stay sample-aligned. Samples is resized without shrinking.
+	// This is the preferred path for high channel counts.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	int32 ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, UPARAM(ref) TArray<float>& Samples);
+
+	// Writes Samples.Num() / NumChannels frames for the channel range; returns the frames accepted by every channel
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	int32 WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, const TArray<float>& Samples);
+
+	// Same as above for the channels whose bit is set in ChannelMask (bit 0 = channel 0, up to 64 channels)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	int32 ReadAudioFramesMasked(int64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, UPARAM(ref) TArray<float>& Samples);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	int32 WriteAudioFramesMasked(int64 ChannelMask, EJackAudioFrameLayout Layout, const TArray<float>& Samples);
+
+	// C++ overloads on caller-owned storage (OutSamples must hold NumChannels * NumFrames floats)
+	int32 ReadAudioFrames(int32 FirstChannel, int32 NumChannels, int32 NumFrames, EJackAudioFrameLayout Layout, TArrayView<float> OutSamples);
+	int32 WriteAudioFrames(int32 FirstChannel, int32 NumChannels, EJackAudioFrameLayout Layout, TConstArrayView<float> Samples);
+	int32 ReadAudioFrames(uint64 ChannelMask, int32 NumFrames, EJackAudioFrameLayout Layout, TArrayView<float> OutSamples);
+	int32 WriteAudioFrames(uint64 ChannelMask, EJackAudioFrameLayout Layout, TConstArrayView<float> Samples);
+
+	// Streams a submix (the main submix when null) straight into the JACK outputs from the audio render thread,
+	// one render block after mixing. ChannelMap[k] is the 0-based JACK output for submix channel k (-1 skips it);
+	// an empty map sends submix channel k to output k. A mixer rate other than JACK's is converted, and the
+	// clock drift between the two is compensated unless disabled in the Clock Drift settings.
+	// Until StopSubmixOutput the mapped outputs belong to the bridge: game-thread writes to them are refused.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	bool StartSubmixOutput(USoundSubmix* Submix, const TArray<int32>& ChannelMap);
+
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Audio")
+	void StopSubmixOutput();
+
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
+	bool IsSubmixOutputActive() const { return SubmixOutputBridge.IsValid(); }
+
+	// Drift correction the submix output currently applies on top of the nominal rate ratio (ppm, 0 when inactive)
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
+	float GetSubmixOutputDriftPpm() const;
+
+	// Heap allocations made by audio I/O calls so far; sample it each tick to confirm a steady state of zero
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	int64 GetAudioBufferAllocationCount() const;
+
+	// Input meters (linear amplitude), computed on the JACK thread; cheap enough to poll every frame
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
 	float GetInputLevel(int32 ChannelIndex) const;
 
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
+	float GetInputPeakLevel(int32 ChannelIndex) const;
+
+	// Zero-copy C++ access to the rings: process input audio / render output audio in place, then Commit.
+	// Each channel must be accessed from a single thread; regions are invalidated by Commit or port changes.
+	FJackAudioRingRegion PeekInputBuffer(int32 ChannelIndex, int32 MaxSamples);
+	void CommitInputBuffer(int32 ChannelIndex, int32 NumSamples);
+	FJackAudioRingRegion PeekOutputBuffer(int32 ChannelIndex, int32 MaxSamples);
+	void CommitOutputBuffer(int32 ChannelIndex, int32 NumSamples);
+
+	// Multichannel ring mode: regions hold interleaved frames of every channel
+	FJackAudioRingRegion PeekInputFrames(int32 MaxFrames);
+	void CommitInputFrames(int32 NumFrames);
+	FJackAudioRingRegion PeekOutputFrames(int32 MaxFrames);
+	void CommitOutputFrames(int32 NumFrames);
+
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Audio")
 	int32 GetSampleRate() const;
 
@@ -57,6 +263,36 @@ public:
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
 	float GetCpuLoad() const;
 
+	// Ports the last JACK cycle processed (connected ones) out of those registered; unconnected ports cost next to nothing
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	void GetActivePortCounts(int32& ActivePorts, int32& RegisteredPorts) const;
+
+	// Duration of our own process callback and its share of the cycle budget. If these stay low while xruns
+	// happen, another client (or the server) is the cause. The threshold is set in the project settings.
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	FJackCallbackTimingStats GetCallbackTimingStats() const;
+
+	// Starts a new measurement window (takes effect on the next JACK cycle)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Info")
+	void ResetCallbackTimingStats();
+
+	// Capture->game (Input) or game->playback (Output) latency of a channel (0-based), sampled now.
+	// Our output ports also advertise their buffering to JACK, so downstream clients can align to us.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Info")
+	bool GetChannelLatency(EJackPortDirection Direction, int32 ChannelIndex, FJackChannelLatency& OutLatency) const;
+
+	// Xruns since the client connected
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	int64 GetXrunCount() const;
+
+	// Xruns per minute over the last WindowSeconds (at most the span of the recent history)
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	float GetXrunRate(float WindowSeconds = 60.0f) const;
+
+	// Most recent xruns, oldest first (up to 128)
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
+	TArray<FJackXrunInfo> GetRecentXruns() const { return RecentXruns; }
+
 	// Client/port discovery
 	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Discovery")
 	TArray<FString> GetConnectedClients() const;
@@ -80,6 +316,51 @@ public:
 	bool DisconnectPortsByIndex(EJackPortDirection SourceType, const FString& SourceClientName, UPARAM(DisplayName="Source Port Number") int32 SourcePortNumber,
 								EJackPortDirection DestType,   const FString& DestClientName,   UPARAM(DisplayName="Destination Port Number") int32 DestPortNumber);
 
+	// Async variants (C++): the JACK calls and queries run on the client's control thread, in order with each
+	// other and with ApplyRoutingMatrix, so the game thread never waits on the server. Futures are fulfilled on
+	// that thread. Blueprint uses the async action nodes in JackAudioLinkAsyncActions.h.
+	TFuture<bool> ConnectPortsAsync(const FString& SourcePort, const FString& DestinationPort);
+	TFuture<bool> DisconnectPortsAsync(const FString& SourcePort, const FString& DestinationPort);
+	TFuture<bool> ConnectPortsByIndexAsync(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+										   EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber);
+	TFuture<bool> DisconnectPortsByIndexAsync(EJackPortDirection SourceType, const FString& SourceClientName, int32 SourcePortNumber,
+											  EJackPortDirection DestType,   const FString& DestClientName,   int32 DestPortNumber);
+	TFuture<TArray<FString>> GetConnectedClientsAsync();
+	TFuture<FJackClientPorts> GetClientPortsAsync(const FString& ClientName);
+
+	// Patches many connections at once: makes the live graph match Edges within Scope, issuing only the
+	// connects/disconnects that differ, on a control thread. OnComplete runs on the game thread with a result
+	// per edge touched.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(AutoCreateRefTerm="OnComplete"))
+	void ApplyRoutingMatrix(const TArray<FJackRoutingEdge>& Edges, EJackRoutingScope Scope, const FOnJackRoutingApplied& OnComplete);
+
+	// C++: the future is fulfilled on the control thread
+	TFuture<FJackRoutingResult> ApplyRoutingMatrix(TArray<FJackRoutingEdge> Edges, EJackRoutingScope Scope);
+
+	// Edge from an output of one client to an input of another by port number (1-based), for ApplyRoutingMatrix.
+	// Resolved from the local graph index; a port that does not exist leaves its name empty (reported as MissingPort).
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Routing")
+	FJackRoutingEdge MakeRoutingEdgeByIndex(const FString& SourceClientName, int32 SourcePortNumber, const FString& DestClientName, int32 DestPortNumber) const;
+
+	// Routing presets. Capture snapshots every audio connection of the graph (from the local graph index, so
+	// no server round-trips) into a new transient preset, kept under PresetName unless it is None.
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing")
+	UJackRoutingPreset* CaptureRoutingPreset(FName PresetName);
+
+	// Same into an existing preset, e.g. a Data Asset to save in the editor (the asset is marked dirty)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing")
+	void CaptureRoutingPresetInto(UJackRoutingPreset* Preset);
+
+	// A preset captured under PresetName, or null
+	UFUNCTION(BlueprintPure, Category="JackAudioLink|Routing")
+	UJackRoutingPreset* FindRoutingPreset(FName PresetName) const;
+
+	// Brings the graph back to Preset through ApplyRoutingMatrix (with the preset's RestoreScope)
+	UFUNCTION(BlueprintCallable, Category="JackAudioLink|Routing", meta=(AutoCreateRefTerm="OnComplete"))
+	void RestoreRoutingPreset(UJackRoutingPreset* Preset, const FOnJackRoutingApplied& OnComplete);
+
+	TFuture<FJackRoutingResult> RestoreRoutingPreset(const UJackRoutingPreset* Preset);
+
 	// Our Unreal JACK client name
 	UFUNCTION(BlueprintPure, Category="JackAudioLink|Info")
 	FString GetJackClientName() const;
@@ -91,6 +372,10 @@ public:
 	UPROPERTY(BlueprintAssignable, Category="JackAudioLink|Events")
 	FOnJackClientDisconnected OnJackClientDisconnected;
 
+	// Broadcast on the game thread, once per xrun, on the tick after it happened
+	UPROPERTY(BlueprintAssignable, Category="JackAudioLink|Events")
+	FOnJackXrun OnJackXrun;
+
 protected:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
@@ -98,6 +383,18 @@ protected:
 private:
 	FTSTicker::FDelegateHandle TickHandle;
 	FTSTicker::FDelegateHandle DebugTickHandle;
+	FTSTicker::FDelegateHandle XrunTickHandle;
+
+	// Drains the client's xrun queue into RecentXruns and broadcasts OnJackXrun
+	bool TickXruns(float DeltaTime);
+	TArray<FJackXrunInfo> RecentXruns;
+
+	TSharedPtr<FJackSubmixOutputBridge, ESPMode::ThreadSafe> SubmixOutputBridge;
+	TWeakObjectPtr<USoundSubmix> SubmixOutputSubmix;
+
+	// Presets captured by name at runtime
+	UPROPERTY(Transient)
+	TMap<FName, TObjectPtr<UJackRoutingPreset>> RoutingPresets;
     
 public:
 	// Internal notifications from JACK manager (dispatched on game thread)
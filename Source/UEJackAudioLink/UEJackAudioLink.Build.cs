@@ -26,6 +26,7 @@ public class UEJackAudioLink : ModuleRules
 			new string[]
 			{
 				"Core",
+				"AudioMixer",
 				"Projects",
 				"Slate",
 				"SlateCore"
@@ -38,6 +39,7 @@ public class UEJackAudioLink : ModuleRules
 			new string[]
 			{
 				"ApplicationCore",
+				"AudioMixerCore",
 				"Engine",
 				"CoreUObject",
 				"DeveloperSettings",
@@ -0,0 +1,273 @@
+#include "JackAudioMixerPlatform.h"
+#include "JackAudioLinkSettings.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogJackAudioMixer, Log, All);
+
+namespace Audio
+{
+	// Speaker order for 1..8 mixer channels; mixer channel k lands on unreal_out_(k+1)
+	static const EAudioMixerChannel::Type JackChannelOrder[] =
+	{
+		EAudioMixerChannel::FrontLeft,
+		EAudioMixerChannel::FrontRight,
+		EAudioMixerChannel::FrontCenter,
+		EAudioMixerChannel::LowFrequency,
+		EAudioMixerChannel::BackLeft,
+		EAudioMixerChannel::BackRight,
+		EAudioMixerChannel::SideLeft,
+		EAudioMixerChannel::SideRight
+	};
+
+	FJackAudioMixerPlatform::FJackAudioMixerPlatform() = default;
+
+	FJackAudioMixerPlatform::~FJackAudioMixerPlatform()
+	{
+		if (bHookInstalled)
+		{
+			FJackProcessHooks::SetHook(nullptr);
+		}
+		if (MismatchTickHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(MismatchTickHandle);
+		}
+	}
+
+	void FJackAudioMixerPlatform::GetStreamFormat(uint32& OutSampleRate, uint32& OutBufferSize, int32& OutNumChannels) const
+	{
+		int32 NumOutputs = 0;
+		if (!FJackProcessHooks::GetStreamFormat(OutSampleRate, OutBufferSize, NumOutputs))
+		{
+			const UJackAudioLinkSettings* Settings = GetDefault<UJackAudioLinkSettings>();
+			OutSampleRate = static_cast<uint32>(Settings->GetSampleRateValue());
+			OutBufferSize = static_cast<uint32>(Settings->GetBufferSizeValue());
+			NumOutputs = Settings->OutputChannels;
+		}
+		// The mixer renders standard layouts only: stereo up to 7.1
+		OutNumChannels = FMath::Clamp(NumOutputs & ~1, 2, static_cast<int32>(UE_ARRAY_COUNT(JackChannelOrder)));
+	}
+
+	bool FJackAudioMixerPlatform::InitializeHardware()
+	{
+#if WITH_JACK
+		bInitialized = true;
+		return true;
+#else
+		UE_LOG(LogJackAudioMixer, Error, TEXT("UEJackAudioMixer: plugin built without JACK (WITH_JACK=0)"));
+		return false;
+#endif
+	}
+
+	bool FJackAudioMixerPlatform::TeardownHardware()
+	{
+		bInitialized = false;
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::GetNumOutputDevices(uint32& OutNumOutputDevices)
+	{
+		OutNumOutputDevices = 1;
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::GetOutputDeviceInfo(const uint32 InDeviceIndex, FAudioPlatformDeviceInfo& OutInfo)
+	{
+		uint32 SampleRate = 0;
+		uint32 BufferSize = 0;
+		int32 NumChannels = 0;
+		GetStreamFormat(SampleRate, BufferSize, NumChannels);
+
+		OutInfo.Reset();
+		OutInfo.Name = TEXT("JACK");
+		OutInfo.DeviceId = TEXT("JACK");
+		OutInfo.bIsSystemDefault = true;
+		OutInfo.SampleRate = static_cast<int32>(SampleRate);
+		OutInfo.NumChannels = NumChannels;
+		OutInfo.Format = EAudioMixerStreamDataFormat::Float;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			OutInfo.OutputChannelArray.Add(JackChannelOrder[Channel]);
+		}
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::GetDefaultOutputDeviceIndex(uint32& OutDefaultDeviceIndex) const
+	{
+		OutDefaultDeviceIndex = 0;
+		return true;
+	}
+
+	FAudioPlatformSettings FJackAudioMixerPlatform::GetPlatformSettings() const
+	{
+		uint32 SampleRate = 0;
+		uint32 BufferSize = 0;
+		int32 NumChannels = 0;
+		GetStreamFormat(SampleRate, BufferSize, NumChannels);
+
+		// One mixer buffer per JACK cycle, with one more queued so the render thread has a period to work in
+		FAudioPlatformSettings Settings;
+		Settings.SampleRate = static_cast<int32>(SampleRate);
+		Settings.CallbackBufferFrameSize = static_cast<int32>(BufferSize);
+		Settings.NumBuffers = 2;
+		return Settings;
+	}
+
+	bool FJackAudioMixerPlatform::OpenAudioStream(const FAudioMixerOpenStreamParams& Params)
+	{
+		if (!bInitialized || AudioStreamInfo.StreamState != EAudioOutputStreamState::Closed)
+		{
+			return false;
+		}
+		// Once connected the stream must run at JACK's rate: the hook writes straight into the port buffers,
+		// so there is nowhere to convert. Without a client yet the rate comes from the settings and is only
+		// checked when JACK starts calling.
+		uint32 JackSampleRate = 0;
+		uint32 JackBufferSize = 0;
+		int32 JackNumOutputs = 0;
+		if (FJackProcessHooks::GetStreamFormat(JackSampleRate, JackBufferSize, JackNumOutputs) && Params.SampleRate != JackSampleRate)
+		{
+			UE_LOG(LogJackAudioMixer, Error, TEXT("UEJackAudioMixer: the mixer asks for %u Hz but JACK runs at %u Hz; not opening the stream"),
+				Params.SampleRate, JackSampleRate);
+			return false;
+		}
+		OpenStreamParams = Params;
+		MismatchedSampleRate.store(0, std::memory_order_relaxed);
+		MismatchedBufferSize.store(0, std::memory_order_relaxed);
+		bWarnedSampleRateChange = false;
+		bWarnedBufferSizeChange = false;
+
+		AudioStreamInfo.Reset();
+		AudioStreamInfo.OutputDeviceIndex = OpenStreamParams.OutputDeviceIndex;
+		AudioStreamInfo.NumOutputFrames = OpenStreamParams.NumFrames;
+		AudioStreamInfo.NumBuffers = OpenStreamParams.NumBuffers;
+		AudioStreamInfo.AudioMixer = OpenStreamParams.AudioMixer;
+		if (!GetOutputDeviceInfo(AudioStreamInfo.OutputDeviceIndex, AudioStreamInfo.DeviceInfo))
+		{
+			return false;
+		}
+		AudioStreamInfo.StreamState = EAudioOutputStreamState::Open;
+		UE_LOG(LogJackAudioMixer, Log, TEXT("UEJackAudioMixer: stream open, %u Hz, %d frames, %d channels%s"),
+			OpenStreamParams.SampleRate, OpenStreamParams.NumFrames, AudioStreamInfo.DeviceInfo.NumChannels,
+			JackSampleRate == 0 ? TEXT(" (JACK not connected yet; format from the plugin settings)") : TEXT(""));
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::CloseAudioStream()
+	{
+		if (AudioStreamInfo.StreamState == EAudioOutputStreamState::Closed)
+		{
+			return false;
+		}
+		StopAudioStream();
+		AudioStreamInfo.StreamState = EAudioOutputStreamState::Closed;
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::StartAudioStream()
+	{
+		if (AudioStreamInfo.StreamState != EAudioOutputStreamState::Open && AudioStreamInfo.StreamState != EAudioOutputStreamState::Stopped)
+		{
+			return false;
+		}
+		BeginGeneratingAudio();
+		// From here JACK drives the mixer; until the client is active nothing is pulled
+		FJackProcessHooks::SetHook(this);
+		bHookInstalled = true;
+		if (!MismatchTickHandle.IsValid())
+		{
+			MismatchTickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FJackAudioMixerPlatform::ReportFormatMismatch), 1.0f);
+		}
+		AudioStreamInfo.StreamState = EAudioOutputStreamState::Running;
+		return true;
+	}
+
+	bool FJackAudioMixerPlatform::StopAudioStream()
+	{
+		if (bHookInstalled)
+		{
+			FJackProcessHooks::SetHook(nullptr);
+			bHookInstalled = false;
+		}
+		if (MismatchTickHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(MismatchTickHandle);
+			MismatchTickHandle.Reset();
+		}
+		if (AudioStreamInfo.StreamState != EAudioOutputStreamState::Stopped && AudioStreamInfo.StreamState != EAudioOutputStreamState::Closed)
+		{
+			StopGeneratingAudio();
+			AudioStreamInfo.StreamState = EAudioOutputStreamState::Stopped;
+		}
+		return true;
+	}
+
+	FAudioPlatformDeviceInfo FJackAudioMixerPlatform::GetPlatformDeviceInfo() const
+	{
+		return AudioStreamInfo.DeviceInfo;
+	}
+
+	void FJackAudioMixerPlatform::OnJackProcess(float* const* OutputBuffers, int32 NumOutputs, int32 NumFrames, uint32 SampleRate)
+	{
+		// Mismatches are only recorded here (logging can block the JACK thread); ReportFormatMismatch logs them
+		if (SampleRate != OpenStreamParams.SampleRate)
+		{
+			// The mixer rate is fixed when the stream opens too; rendering it into a server at another rate plays at the wrong pitch
+			MismatchedSampleRate.store(SampleRate, std::memory_order_relaxed);
+			return;
+		}
+		if (NumFrames != OpenStreamParams.NumFrames)
+		{
+			// The mixer buffer size is fixed when the stream opens; a server restart with another size needs a new device
+			MismatchedBufferSize.store(NumFrames, std::memory_order_relaxed);
+			return;
+		}
+		CycleOutputs = OutputBuffers;
+		CycleNumOutputs = NumOutputs;
+		CycleNumFrames = NumFrames;
+		// Hands the next rendered buffer to SubmitBuffer and wakes the render thread for the one after
+		ReadNextBuffer();
+		CycleOutputs = nullptr;
+		CycleNumOutputs = 0;
+	}
+
+	bool FJackAudioMixerPlatform::ReportFormatMismatch(float DeltaTime)
+	{
+		const uint32 SampleRate = MismatchedSampleRate.load(std::memory_order_relaxed);
+		if (SampleRate != 0 && !bWarnedSampleRateChange)
+		{
+			bWarnedSampleRateChange = true;
+			UE_LOG(LogJackAudioMixer, Warning, TEXT("UEJackAudioMixer: JACK runs at %u Hz but the mixer renders at %u Hz; output muted until the audio device is recreated"),
+				SampleRate, OpenStreamParams.SampleRate);
+		}
+		const int32 BufferSize = MismatchedBufferSize.load(std::memory_order_relaxed);
+		if (BufferSize != 0 && !bWarnedBufferSizeChange)
+		{
+			bWarnedBufferSizeChange = true;
+			UE_LOG(LogJackAudioMixer, Warning, TEXT("UEJackAudioMixer: JACK buffer size is %d but the mixer renders %d frames; output muted until the audio device is recreated"),
+				BufferSize, OpenStreamParams.NumFrames);
+		}
+		return true;
+	}
+
+	void FJackAudioMixerPlatform::SubmitBuffer(const uint8* Buffer)
+	{
+		if (!CycleOutputs || !Buffer)
+		{
+			return;
+		}
+		const float* Frames = reinterpret_cast<const float*>(Buffer);
+		const int32 NumChannels = AudioStreamInfo.DeviceInfo.NumChannels;
+		const int32 NumMapped = FMath::Min(NumChannels, CycleNumOutputs);
+		for (int32 Channel = 0; Channel < NumMapped; ++Channel)
+		{
+			float* Out = CycleOutputs[Channel];
+			if (!Out)
+			{
+				continue;
+			}
+			for (int32 Frame = 0; Frame < CycleNumFrames; ++Frame)
+			{
+				Out[Frame] += Frames[Frame * NumChannels + Channel];
+			}
+		}
+	}
+}
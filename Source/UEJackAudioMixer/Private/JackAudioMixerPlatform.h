@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AudioMixer.h"
+#include "Containers/Ticker.h"
+#include "JackProcessHook.h"
+#include <atomic>
+
+namespace Audio
+{
+	// IAudioMixerPlatformInterface on top of the plugin's JACK client: every JACK cycle pulls one mixer
+	// buffer (ReadNextBuffer) and mixes it into unreal_out_N, mixer channel k going to unreal_out_(k+1).
+	// The stream uses JACK's sample rate and buffer size, so there is no second device and no ring in between.
+	class FJackAudioMixerPlatform : public IAudioMixerPlatformInterface, public IJackProcessHook
+	{
+	public:
+		FJackAudioMixerPlatform();
+		virtual ~FJackAudioMixerPlatform() override;
+
+		//~ Begin IAudioMixerPlatformInterface
+		virtual FString GetPlatformApi() const override { return TEXT("JACK"); }
+		virtual bool InitializeHardware() override;
+		virtual bool TeardownHardware() override;
+		virtual bool IsInitialized() const override { return bInitialized; }
+		virtual bool GetNumOutputDevices(uint32& OutNumOutputDevices) override;
+		virtual bool GetOutputDeviceInfo(const uint32 InDeviceIndex, FAudioPlatformDeviceInfo& OutInfo) override;
+		virtual bool GetDefaultOutputDeviceIndex(uint32& OutDefaultDeviceIndex) const override;
+		virtual bool OpenAudioStream(const FAudioMixerOpenStreamParams& Params) override;
+		virtual bool CloseAudioStream() override;
+		virtual bool StartAudioStream() override;
+		virtual bool StopAudioStream() override;
+		virtual FAudioPlatformDeviceInfo GetPlatformDeviceInfo() const override;
+		virtual void SubmitBuffer(const uint8* Buffer) override;
+		virtual FString GetDefaultDeviceName() override { return TEXT("JACK"); }
+		virtual FAudioPlatformSettings GetPlatformSettings() const override;
+		//~ End IAudioMixerPlatformInterface
+
+		//~ Begin IJackProcessHook
+		virtual void OnJackProcess(float* const* OutputBuffers, int32 NumOutputs, int32 NumFrames, uint32 SampleRate) override;
+		//~ End IJackProcessHook
+
+	private:
+		// JACK's format when connected, otherwise the plugin settings
+		void GetStreamFormat(uint32& OutSampleRate, uint32& OutBufferSize, int32& OutNumChannels) const;
+		// Game-thread ticker: logs the format mismatches OnJackProcess recorded, once per stream
+		bool ReportFormatMismatch(float DeltaTime);
+
+		bool bInitialized = false;
+		bool bHookInstalled = false;
+
+		// Valid only during OnJackProcess, for SubmitBuffer
+		float* const* CycleOutputs = nullptr;
+		int32 CycleNumOutputs = 0;
+		int32 CycleNumFrames = 0;
+		// Set by OnJackProcess, which must not log on the JACK thread; 0 while the format matches
+		std::atomic<uint32> MismatchedSampleRate{0};
+		std::atomic<int32> MismatchedBufferSize{0};
+		FTSTicker::FDelegateHandle MismatchTickHandle;
+		bool bWarnedBufferSizeChange = false;
+		bool bWarnedSampleRateChange = false;
+	};
+}
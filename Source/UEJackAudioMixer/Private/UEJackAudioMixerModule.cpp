@@ -0,0 +1,17 @@
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "AudioDevice.h"
+#include "JackAudioMixerPlatform.h"
+
+class FUEJackAudioMixerModule : public IAudioDeviceModule
+{
+public:
+	virtual bool IsAudioMixerModule() const override { return true; }
+
+	virtual Audio::IAudioMixerPlatformInterface* CreateAudioMixerPlatformInterface() override
+	{
+		return new Audio::FJackAudioMixerPlatform();
+	}
+};
+
+IMPLEMENT_MODULE(FUEJackAudioMixerModule, UEJackAudioMixer);
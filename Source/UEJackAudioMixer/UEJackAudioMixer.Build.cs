@@ -0,0 +1,25 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+// Audio mixer platform backend that renders UE's main audio device inside the JACK process callback.
+// Selected per platform with [Audio] AudioMixerModuleName=UEJackAudioMixer in the platform Engine.ini.
+public class UEJackAudioMixer : ModuleRules
+{
+	public UEJackAudioMixer(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"AudioMixer",
+				"AudioMixerCore",
+				"UEJackAudioLink"
+			}
+			);
+	}
+}